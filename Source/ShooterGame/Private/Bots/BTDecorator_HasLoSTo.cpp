@@ -7,6 +7,7 @@
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "Bots/ShooterBot.h"
 #include "Bots/ShooterAIController.h"
+#include "Bots/ShooterBotPerception.h"
 #include "Online/ShooterPlayerState.h"
 
 UBTDecorator_HasLoSTo::UBTDecorator_HasLoSTo(const FObjectInitializer& ObjectInitializer)
@@ -16,65 +17,133 @@ UBTDecorator_HasLoSTo::UBTDecorator_HasLoSTo(const FObjectInitializer& ObjectIni
 	// accept only actors and vectors	
 	EnemyKey.AddObjectFilter(this, *NodeName, AActor::StaticClass());
 	EnemyKey.AddVectorFilter(this, *NodeName);
+
+	MaxResultAge = 0.2f;
+
+	bNotifyBecomeRelevant = true;
+	bNotifyCeaseRelevant = true;
+	bNotifyTick = true;
+}
+
+uint16 UBTDecorator_HasLoSTo::GetInstanceMemorySize() const
+{
+	return sizeof(FBTHasLoSToMemory);
 }
 
-/*
-bool UBTDecorator_HasLoSTo::CalculateRawConditionValue(class UBehaviorTreeComponent* OwnerComp, uint8* NodeMemory) const
+void UBTDecorator_HasLoSTo::InitializeFromAsset(UBehaviorTree& Asset)
 {
-	const UBlackboardComponent* BlackboardComp = OwnerComp->GetBlackboardComponent();
-	if (BlackboardComp == NULL)
+	Super::InitializeFromAsset(Asset);
+
+	UBlackboardData* BBAsset = GetBlackboardAsset();
+	if (BBAsset)
 	{
-		return false;
+		EnemyKey.ResolveSelectedKey(*BBAsset);
 	}
+}
 
-	FVector PointA = FVector::ZeroVector;
-	FVector PointB = FVector::ZeroVector;
-	const bool bHasPointA = BlackboardComp->GetLocationFromEntry(BlackboardKeyA.GetSelectedKeyID(), PointA);
-	const bool bHasPointB = BlackboardComp->GetLocationFromEntry(BlackboardKeyB.GetSelectedKeyID(), PointB);
+void UBTDecorator_HasLoSTo::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	new(NodeMemory) FBTHasLoSToMemory();
 
-	bool bHasPath = false;
+	FBTHasLoSToMemory* MyMemory = CastInstanceNodeMemory<FBTHasLoSToMemory>(NodeMemory);
+	MyMemory->bHasLOS = false;
+	MyMemory->bHasResult = false;
+	MyMemory->bDirty = true;
+	MyMemory->Timestamp = 0.0f;
+}
 
-	const UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(OwnerComp->GetWorld());
-	if (NavSys && bHasPointA && bHasPointB)
+void UBTDecorator_HasLoSTo::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	if (BlackboardComp)
 	{
-		const AAIController* AIOwner = Cast<AAIController>(OwnerComp->GetOwner());
-		const ANavigationData* NavData = AIOwner && AIOwner->NavComponent ? AIOwner->NavComponent->GetNavData() : NULL;
-		TSharedPtr<const FNavigationQueryFilter> QueryFilter = UNavigationQueryFilter::GetQueryFilter(NavData, FilterClass);
+		BlackboardComp->RegisterObserver(EnemyKey.GetSelectedKeyID(), this, FOnBlackboardChangeNotification::CreateUObject(this, &UBTDecorator_HasLoSTo::OnBlackboardKeyValueChange));
+	}
+}
 
-		if (PathQueryType == EPathExistanceQueryType::NavmeshRaycast2D)
-		{
-#if WITH_RECAST
-			const ARecastNavMesh* RecastNavMesh = Cast<const ARecastNavMesh>(NavData);
-			bHasPath = RecastNavMesh && RecastNavMesh->IsSegmentOnNavmesh(PointA, PointB, QueryFilter);
-#endif
-		}
-		else
+void UBTDecorator_HasLoSTo::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	if (BlackboardComp)
+	{
+		BlackboardComp->UnregisterObserversFrom(this);
+	}
+
+	// drop pending trace, result is refreshed when we become relevant again
+	FBTHasLoSToMemory* MyMemory = CastInstanceNodeMemory<FBTHasLoSToMemory>(NodeMemory);
+	MyMemory->TraceHandle = FTraceHandle();
+	MyMemory->bDirty = true;
+}
+
+void UBTDecorator_HasLoSTo::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	if (UpdateLOS(OwnerComp, CastInstanceNodeMemory<FBTHasLoSToMemory>(NodeMemory)))
+	{
+		OwnerComp.RequestExecution(this);
+	}
+}
+
+EBlackboardNotificationResult UBTDecorator_HasLoSTo::OnBlackboardKeyValueChange(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID)
+{
+	UBehaviorTreeComponent* OwnerComp = Cast<UBehaviorTreeComponent>(Blackboard.GetBrainComponent());
+	if (OwnerComp == NULL)
+	{
+		return EBlackboardNotificationResult::RemoveObserver;
+	}
+
+	uint8* NodeMemory = OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this));
+	if (NodeMemory)
+	{
+		FBTHasLoSToMemory* MyMemory = CastInstanceNodeMemory<FBTHasLoSToMemory>(NodeMemory);
+		MyMemory->bDirty = true;
+		MyMemory->TraceHandle = FTraceHandle();
+
+		if (UpdateLOS(*OwnerComp, MyMemory))
 		{
-			EPathFindingMode::Type TestMode = (PathQueryType == EPathExistanceQueryType::HierarchicalQuery) ? EPathFindingMode::Hierarchical : EPathFindingMode::Regular;
-			bHasPath = NavSys->TestPathSync(FPathFindingQuery(AIOwner, NavData, PointA, PointB, QueryFilter), TestMode);
+			OwnerComp->RequestExecution(this);
 		}
 	}
 
-	return bHasPath;
-}*/
+	return EBlackboardNotificationResult::ContinueObserving;
+}
 
 bool UBTDecorator_HasLoSTo::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
 {
+	FBTHasLoSToMemory* MyMemory = CastInstanceNodeMemory<FBTHasLoSToMemory>(NodeMemory);
+	UpdateLOS(OwnerComp, MyMemory);
+
+	return MyMemory->bHasLOS;
+}
+
+bool UBTDecorator_HasLoSTo::UpdateLOS(UBehaviorTreeComponent& OwnerComp, FBTHasLoSToMemory* MyMemory) const
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (!MyMemory->bDirty && MyMemory->bHasResult && (Now - MyMemory->Timestamp) < MaxResultAge)
+	{
+		return false;
+	}
+
+	// location result is still on its way
+	if (!MyMemory->bDirty && MyMemory->TraceHandle.IsValid())
+	{
+		return false;
+	}
+
 	const UBlackboardComponent* MyBlackboard = OwnerComp.GetBlackboardComponent();
 	AAIController* MyController = OwnerComp.GetAIOwner();
-	bool HasLOS = false;
+	APawn* MyBot = MyController ? MyController->GetPawn() : NULL;
+	const bool bOldHasLOS = MyMemory->bHasLOS;
 
-	if (MyController && MyBlackboard)
+	MyMemory->bDirty = false;
+
+	FVector TargetLocation = FVector::ZeroVector;
+	bool bGotTarget = false;
+	AActor* EnemyActor = NULL;
+	if (MyBlackboard && MyBot)
 	{
-		auto MyID = MyBlackboard->GetKeyID(EnemyKey.SelectedKeyName);
-		auto TargetKeyType = MyBlackboard->GetKeyType(MyID);
-		
-		FVector TargetLocation;
-		bool bGotTarget = false;
-		AActor* EnemyActor = NULL;
-		if (TargetKeyType == UBlackboardKeyType_Object::StaticClass())
+		if (EnemyKey.SelectedKeyType == UBlackboardKeyType_Object::StaticClass())
 		{
-			UObject* KeyValue = MyBlackboard->GetValue<UBlackboardKeyType_Object>(MyID);
+			UObject* KeyValue = MyBlackboard->GetValue<UBlackboardKeyType_Object>(EnemyKey.GetSelectedKeyID());
 			EnemyActor = Cast<AActor>(KeyValue);
 			if (EnemyActor)
 			{
@@ -82,83 +151,120 @@ bool UBTDecorator_HasLoSTo::CalculateRawConditionValue(UBehaviorTreeComponent& O
 				bGotTarget = true;
 			}
 		}
-		else if (TargetKeyType == UBlackboardKeyType_Vector::StaticClass())
+		else if (EnemyKey.SelectedKeyType == UBlackboardKeyType_Vector::StaticClass())
 		{
-			TargetLocation = MyBlackboard->GetValue<UBlackboardKeyType_Vector>(MyID);
+			TargetLocation = MyBlackboard->GetValue<UBlackboardKeyType_Vector>(EnemyKey.GetSelectedKeyID());
 			bGotTarget = true;
 		}
+	}
 
-		if (bGotTarget== true )
+	if (bGotTarget == false)
+	{
+		MyMemory->bHasLOS = false;
+		MyMemory->bHasResult = true;
+		MyMemory->Timestamp = Now;
+	}
+	else if (EnemyActor != NULL)
+	{
+		// Actor targets share the batched trace with the controller
+		UShooterBotPerception* Perception = GetWorld()->GetSubsystem<UShooterBotPerception>();
+		AShooterAIController* ShooterController = Cast<AShooterAIController>(MyController);
+		const float MaxAgeScale = ShooterController ? UShooterBotLODManager::GetPerceptionAgeScale(ShooterController->GetLODLevel()) : 1.0f;
+		FBotLOSResult LOS;
+		if (Perception && Perception->GetLOS(MyBot, EnemyActor, LOS, MaxAgeScale))
 		{
-			if (LOSTrace(OwnerComp.GetOwner(), EnemyActor, TargetLocation) == true)
-			{
-				HasLOS = true;
-			}
-		}			
+			MyMemory->bHasLOS = IsLOSHit(MyController, LOS.bBlockingHit, LOS.HitActor.Get(), FVector::ZeroVector, EnemyActor, FVector::ZeroVector, TargetLocation);
+			MyMemory->bHasResult = true;
+			MyMemory->Timestamp = Now;
+		}
 	}
+	else
+	{
+		FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AILosTrace), true, MyController);
+		TraceParams.AddIgnoredActor(MyBot);
+
+		MyMemory->TraceStart = MyBot->GetActorLocation();
+		MyMemory->TraceEnd = TargetLocation;
 
-	return HasLOS;
+		FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &UBTDecorator_HasLoSTo::OnTraceCompleted, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp));
+		MyMemory->TraceHandle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, MyMemory->TraceStart, MyMemory->TraceEnd, COLLISION_WEAPON,
+			TraceParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate);
+	}
+
+	return MyMemory->bHasLOS != bOldHasLOS;
 }
 
-bool UBTDecorator_HasLoSTo::LOSTrace(AActor* InActor, AActor* InEnemyActor, const FVector& EndLocation) const
+void UBTDecorator_HasLoSTo::OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp) const
 {
-	AShooterAIController* MyController = Cast<AShooterAIController>(InActor);
-	AShooterBot* MyBot = MyController ? Cast<AShooterBot>(MyController->GetPawn()) : NULL; 
+	if (!OwnerComp.IsValid())
+	{
+		return;
+	}
+
+	uint8* NodeMemory = OwnerComp->GetNodeMemory(const_cast<UBTDecorator_HasLoSTo*>(this), OwnerComp->FindInstanceContainingNode(this));
+	FBTHasLoSToMemory* MyMemory = NodeMemory ? CastInstanceNodeMemory<FBTHasLoSToMemory>(NodeMemory) : NULL;
+	if (MyMemory == NULL || MyMemory->TraceHandle != Handle)
+	{
+		// superseded by key change or no longer relevant
+		return;
+	}
+
+	const FHitResult* Hit = Datum.OutHits.FindByPredicate([](const FHitResult& TestHit) { return TestHit.bBlockingHit; });
+	const bool bOldHasLOS = MyMemory->bHasLOS;
 
+	MyMemory->TraceHandle = FTraceHandle();
+	MyMemory->bHasLOS = IsLOSHit(OwnerComp->GetAIOwner(), Hit != NULL, Hit ? Hit->GetActor() : NULL, Hit ? FVector(Hit->ImpactPoint) : FVector::ZeroVector, NULL, MyMemory->TraceStart, MyMemory->TraceEnd);
+	MyMemory->bHasResult = true;
+	MyMemory->Timestamp = GetWorld()->GetTimeSeconds();
+
+	if (MyMemory->bHasLOS != bOldHasLOS)
+	{
+		OwnerComp->RequestExecution(this);
+	}
+}
+
+bool UBTDecorator_HasLoSTo::IsLOSHit(AController* MyController, bool bBlockingHit, AActor* HitActor, const FVector& ImpactPoint, AActor* InEnemyActor, const FVector& StartLocation, const FVector& EndLocation) const
+{
 	bool bHasLOS = false;
+	if (MyController != NULL && bBlockingHit == true)
 	{
-		if (MyBot != NULL)
+		// We hit something. If we have an actor supplied, just check if the hit actor is an enemy. If it is consider that 'has LOS'
+		if (HitActor != NULL)
 		{
-			// Perform trace to retrieve hit info
-			FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AILosTrace), true, InActor);
-			
-			TraceParams.bReturnPhysicalMaterial = true;
-			TraceParams.AddIgnoredActor(MyBot);
-			const FVector StartLocation = MyBot->GetActorLocation();
-			FHitResult Hit(ForceInit);
-			GetWorld()->LineTraceSingleByChannel(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
-			if (Hit.bBlockingHit == true)
+			// If the hit is our target actor consider it LOS
+			if (HitActor == InEnemyActor)
+			{
+				bHasLOS = true;
+			}
+			else
 			{
-				// We hit something. If we have an actor supplied, just check if the hit actor is an enemy. If it is consider that 'has LOS'
-				AActor* HitActor = Hit.GetActor();
-				if (Hit.GetActor() != NULL)
+				// Check the team of us against the team of the actor we hit if we are able. If they dont match good to go.
+				ACharacter* HitChar = Cast<ACharacter>(HitActor);
+				if ( (HitChar != NULL)
+					&& (MyController->PlayerState != NULL) && (HitChar->GetPlayerState() != NULL))
 				{
-					// If the hit is our target actor consider it LOS
-					if (HitActor == InActor)
-					{
-						bHasLOS = true;
-					}
-					else
+					AShooterPlayerState* HitPlayerState = Cast<AShooterPlayerState>(HitChar->GetPlayerState());
+					AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(MyController->PlayerState);
+					if ((HitPlayerState != NULL) && (MyPlayerState != NULL))
 					{
-						// Check the team of us against the team of the actor we hit if we are able. If they dont match good to go.
-						ACharacter* HitChar = Cast<ACharacter>(HitActor);
-						if ( (HitChar != NULL)
-							&& (MyController->PlayerState != NULL) && (HitChar->GetPlayerState() != NULL))
+						if (HitPlayerState->GetTeamNum() != MyPlayerState->GetTeamNum())
 						{
-							AShooterPlayerState* HitPlayerState = Cast<AShooterPlayerState>(HitChar->GetPlayerState());
-							AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(MyController->PlayerState);
-							if ((HitPlayerState != NULL) && (MyPlayerState != NULL))
-							{
-								if (HitPlayerState->GetTeamNum() != MyPlayerState->GetTeamNum())
-								{
-									bHasLOS = true;
-								}
-							}
+							bHasLOS = true;
 						}
 					}
 				}
-				else //we didnt hit an actor
+			}
+		}
+		else //we didnt hit an actor
+		{
+			if (InEnemyActor == NULL)
+			{
+				// We were not given an actor - so check of the distance between what we hit and the target. If what we hit is further away than the target we should be able to hit our target.
+				FVector HitDelta = ImpactPoint - StartLocation;
+				FVector TargetDelta = EndLocation - StartLocation;
+				if (TargetDelta.SizeSquared() < HitDelta.SizeSquared())
 				{
-					if (InEnemyActor == NULL)
-					{
-						// We were not given an actor - so check of the distance between what we hit and the target. If what we hit is further away than the target we should be able to hit our target.
-						FVector HitDelta = Hit.ImpactPoint - StartLocation;
-						FVector TargetDelta = EndLocation - StartLocation;
-						if (TargetDelta.SizeSquared() < HitDelta.SizeSquared())
-						{
-							bHasLOS = true;
-						}
-					}
+					bHasLOS = true;
 				}
 			}
 		}
@@ -13,6 +13,7 @@
 UBTTask_FindPickup::UBTTask_FindPickup(const FObjectInitializer& ObjectInitializer) 
 	: Super(ObjectInitializer)
 {
+	bUsePathCost = false;
 }
 
 EBTNodeResult::Type UBTTask_FindPickup::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
@@ -30,23 +31,7 @@ EBTNodeResult::Type UBTTask_FindPickup::ExecuteTask(UBehaviorTreeComponent& Owne
 		return EBTNodeResult::Failed;
 	}
 
-	const FVector MyLoc = MyBot->GetActorLocation();
-	AShooterPickup_Ammo* BestPickup = NULL;
-	float BestDistSq = MAX_FLT;
-
-	for (int32 i = 0; i < GameMode->LevelPickups.Num(); ++i)
-	{
-		AShooterPickup_Ammo* AmmoPickup = Cast<AShooterPickup_Ammo>(GameMode->LevelPickups[i]);
-		if (AmmoPickup && AmmoPickup->IsForWeapon(AShooterWeapon_Instant::StaticClass()) && AmmoPickup->CanBePickedUp(MyBot))
-		{
-			const float DistSq = (AmmoPickup->GetActorLocation() - MyLoc).SizeSquared();
-			if (BestDistSq == -1 || DistSq < BestDistSq)
-			{
-				BestDistSq = DistSq;
-				BestPickup = AmmoPickup;
-			}
-		}
-	}
+	AShooterPickup* BestPickup = GameMode->GetPickupIndex().FindNearestAvailable(AShooterPickup_Ammo::StaticClass(), AShooterWeapon_Instant::StaticClass(), MyBot, bUsePathCost);
 
 	if (BestPickup)
 	{
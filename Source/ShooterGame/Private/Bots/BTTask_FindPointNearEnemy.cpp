@@ -3,21 +3,37 @@
 #include "ShooterGame.h"
 #include "Bots/BTTask_FindPointNearEnemy.h"
 #include "Bots/ShooterAIController.h"
+#include "Bots/ShooterNavQueries.h"
+#include "Bots/ShooterInfluenceMap.h"
+#include "Online/ShooterPlayerState.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyAllTypes.h"
-#include "NavigationSystem.h"
 
 
 UBTTask_FindPointNearEnemy::UBTTask_FindPointNearEnemy(const FObjectInitializer& ObjectInitializer) 
 	: Super(ObjectInitializer)
 {
+	NumCandidateDirections = 8;
+	ThreatWeight = 1.0f;
+	DeathHeatWeight = 0.5f;
+	FriendlyWeight = 0.25f;
+	MaxPathLength = 0.0f;
+}
+
+uint16 UBTTask_FindPointNearEnemy::GetInstanceMemorySize() const
+{
+	return sizeof(FBTFindPointNearEnemyMemory);
 }
 
 EBTNodeResult::Type UBTTask_FindPointNearEnemy::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	FBTFindPointNearEnemyMemory* MyMemory = CastInstanceNodeMemory<FBTFindPointNearEnemyMemory>(NodeMemory);
+	MyMemory->RequestId = 0;
+
 	AShooterAIController* MyController = Cast<AShooterAIController>(OwnerComp.GetAIOwner());
-	if (MyController == NULL)
+	UShooterNavQueries* NavQueries = GetWorld()->GetSubsystem<UShooterNavQueries>();
+	if (MyController == NULL || NavQueries == NULL)
 	{
 		return EBTNodeResult::Failed;
 	}
@@ -27,15 +43,111 @@ EBTNodeResult::Type UBTTask_FindPointNearEnemy::ExecuteTask(UBehaviorTreeCompone
 	if (Enemy && MyBot)
 	{
 		const float SearchRadius = 200.0f;
-		const FVector SearchOrigin = Enemy->GetActorLocation() + 600.0f * (MyBot->GetActorLocation() - Enemy->GetActorLocation()).GetSafeNormal();
-		FVector Loc(0);
-		UNavigationSystemV1::K2_GetRandomReachablePointInRadius(MyController, SearchOrigin, Loc, SearchRadius);
-		if (Loc != FVector::ZeroVector)
+		const FVector ToBot = (MyBot->GetActorLocation() - Enemy->GetActorLocation()).GetSafeNormal2D();
+		FVector SearchOrigin = Enemy->GetActorLocation() + 600.0f * ToBot;
+
+		// look around the enemy for the side with the least heat, preferring our side
+		UShooterInfluenceMap* InfluenceMap = GetWorld()->GetSubsystem<UShooterInfluenceMap>();
+		const AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(MyController->PlayerState);
+		if (InfluenceMap && MyPlayerState && !ToBot.IsZero())
 		{
-			OwnerComp.GetBlackboardComponent()->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), Loc);
-			return EBTNodeResult::Succeeded;
+			const int32 MyTeamNum = MyPlayerState->GetTeamNum();
+			float BestScore = -MAX_FLT;
+			for (int32 i = 0; i < NumCandidateDirections; i++)
+			{
+				const FVector Dir = ToBot.RotateAngleAxis(360.0f * i / NumCandidateDirections, FVector::UpVector);
+				const FVector Candidate = Enemy->GetActorLocation() + 600.0f * Dir;
+				const float Score = (Dir | ToBot)
+					- ThreatWeight * InfluenceMap->GetThreat(Candidate, MyTeamNum, MyBot)
+					- DeathHeatWeight * InfluenceMap->GetDeathHeat(Candidate)
+					+ FriendlyWeight * InfluenceMap->GetFriendlyPresence(Candidate, MyTeamNum, MyBot);
+				if (Score > BestScore)
+				{
+					BestScore = Score;
+					SearchOrigin = Candidate;
+				}
+			}
+		}
+
+		MyMemory->RequestId = NavQueries->RequestReachablePoint(MyController, SearchOrigin, SearchRadius,
+			FShooterNavPointQueryDelegate::CreateUObject(this, &UBTTask_FindPointNearEnemy::OnPointFound, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)));
+		if (MyMemory->RequestId != 0)
+		{
+			return EBTNodeResult::InProgress;
 		}
 	}
 
 	return EBTNodeResult::Failed;
 }
+
+EBTNodeResult::Type UBTTask_FindPointNearEnemy::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FBTFindPointNearEnemyMemory* MyMemory = CastInstanceNodeMemory<FBTFindPointNearEnemyMemory>(NodeMemory);
+	UShooterNavQueries* NavQueries = GetWorld()->GetSubsystem<UShooterNavQueries>();
+	if (NavQueries)
+	{
+		NavQueries->CancelRequest(MyMemory->RequestId);
+	}
+	MyMemory->RequestId = 0;
+
+	return EBTNodeResult::Aborted;
+}
+
+FBTFindPointNearEnemyMemory* UBTTask_FindPointNearEnemy::GetPendingMemory(UBehaviorTreeComponent& OwnerComp, uint32 RequestId)
+{
+	uint8* NodeMemory = OwnerComp.GetNodeMemory(this, OwnerComp.FindInstanceContainingNode(this));
+	FBTFindPointNearEnemyMemory* MyMemory = NodeMemory ? CastInstanceNodeMemory<FBTFindPointNearEnemyMemory>(NodeMemory) : NULL;
+	if (MyMemory == NULL || MyMemory->RequestId != RequestId)
+	{
+		// task was aborted or restarted meanwhile
+		return NULL;
+	}
+
+	return MyMemory;
+}
+
+void UBTTask_FindPointNearEnemy::OnPointFound(uint32 RequestId, bool bSuccess, const FVector& Point, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	FBTFindPointNearEnemyMemory* MyMemory = OwnerComp.IsValid() ? GetPendingMemory(*OwnerComp, RequestId) : NULL;
+	if (MyMemory == NULL)
+	{
+		return;
+	}
+
+	MyMemory->RequestId = 0;
+
+	// the point is reachable from the search origin, make sure the bot can walk there too
+	AAIController* MyController = OwnerComp->GetAIOwner();
+	APawn* MyBot = MyController ? MyController->GetPawn() : NULL;
+	UShooterNavQueries* NavQueries = GetWorld()->GetSubsystem<UShooterNavQueries>();
+	if (bSuccess && MyBot && NavQueries)
+	{
+		MyMemory->RequestId = NavQueries->RequestPath(MyController, MyBot->GetActorLocation(), Point,
+			FShooterNavPathQueryDelegate::CreateUObject(this, &UBTTask_FindPointNearEnemy::OnPathFound, Point, OwnerComp));
+		if (MyMemory->RequestId != 0)
+		{
+			return;
+		}
+	}
+
+	FinishLatentTask(*OwnerComp, EBTNodeResult::Failed);
+}
+
+void UBTTask_FindPointNearEnemy::OnPathFound(uint32 RequestId, bool bPathExists, float PathLength, FVector Point, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	FBTFindPointNearEnemyMemory* MyMemory = OwnerComp.IsValid() ? GetPendingMemory(*OwnerComp, RequestId) : NULL;
+	if (MyMemory == NULL)
+	{
+		return;
+	}
+
+	MyMemory->RequestId = 0;
+
+	const bool bSuccess = bPathExists && (MaxPathLength <= 0.0f || PathLength <= MaxPathLength);
+	if (bSuccess)
+	{
+		OwnerComp->GetBlackboardComponent()->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), Point);
+	}
+
+	FinishLatentTask(*OwnerComp, bSuccess ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+}
@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "Bots/ShooterAIController.h"
+#include "Bots/ShooterBehaviorTreeComponent.h"
 #include "Bots/ShooterBot.h"
 #include "Online/ShooterPlayerState.h"
 #include "BehaviorTree/BehaviorTree.h"
@@ -10,14 +11,24 @@
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "Weapons/ShooterWeapon.h"
+#include "Player/ShooterPawnRegistry.h"
+#include "Bots/ShooterBotPerception.h"
+#include "Bots/ShooterBotThinkScheduler.h"
+#include "Bots/ShooterCrowdManager.h"
+#include "Navigation/PathFollowingComponent.h"
 
 AShooterAIController::AShooterAIController(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
  	BlackboardComp = ObjectInitializer.CreateDefaultSubobject<UBlackboardComponent>(this, TEXT("BlackBoardComp"));
  	
-	BrainComponent = BehaviorComp = ObjectInitializer.CreateDefaultSubobject<UBehaviorTreeComponent>(this, TEXT("BehaviorComp"));	
+	BrainComponent = BehaviorComp = ObjectInitializer.CreateDefaultSubobject<UShooterBehaviorTreeComponent>(this, TEXT("BehaviorComp"));	
 
 	bWantsPlayerState = true;
+
+	LODLevel = EShooterBotLOD::Near;
+	CrowdEntityIndex = INDEX_NONE;
+	bCrowdBot = false;
+	ThinkPhase = INDEX_NONE;
 }
 
 void AShooterAIController::OnPossess(APawn* InPawn)
@@ -37,21 +48,126 @@ void AShooterAIController::OnPossess(APawn* InPawn)
 		EnemyKeyID = BlackboardComp->GetKeyID("Enemy");
 		NeedAmmoKeyID = BlackboardComp->GetKeyID("NeedAmmo");
 
-		BehaviorComp->StartTree(*(Bot->BotBehavior));
+		// bots restarted in the same frame would otherwise run their services in lockstep
+		UShooterBotThinkScheduler* ThinkScheduler = GetWorld()->GetSubsystem<UShooterBotThinkScheduler>();
+		if (ThinkScheduler && ThinkPhase == INDEX_NONE)
+		{
+			ThinkPhase = ThinkScheduler->AcquirePhase();
+		}
+
+		const float StartDelay = ThinkScheduler ? ThinkScheduler->GetPhaseDelay(ThinkPhase) : 0.0f;
+		if (StartDelay > 0.0f)
+		{
+			GetWorldTimerManager().SetTimer(TimerHandle_StartBehavior, this, &AShooterAIController::StartBehavior, StartDelay, false);
+		}
+		else
+		{
+			StartBehavior();
+		}
+	}
+
+	ApplyLODLevel();
+
+	UShooterBotLODManager* LODManager = GetWorld()->GetSubsystem<UShooterBotLODManager>();
+	if (LODManager)
+	{
+		LODManager->RegisterBot(this);
 	}
 }
 
 void AShooterAIController::OnUnPossess()
 {
+	GetWorldTimerManager().ClearTimer(TimerHandle_StartBehavior);
+	GetWorldTimerManager().ClearTimer(TimerHandle_ApplyLODLevel);
+
+	// give the pawn back its full update rate
+	LODLevel = EShooterBotLOD::Near;
+	ApplyLODLevel();
+
+	UShooterBotLODManager* LODManager = GetWorld()->GetSubsystem<UShooterBotLODManager>();
+	if (LODManager)
+	{
+		LODManager->UnregisterBot(this);
+	}
+
 	Super::OnUnPossess();
 
 	BehaviorComp->StopTree();
 }
 
+void AShooterAIController::SetLODLevel(EShooterBotLOD::Type NewLODLevel)
+{
+	if (LODLevel != NewLODLevel)
+	{
+		LODLevel = NewLODLevel;
+
+		// new tick intervals start counting when applied, keep them in our think phase
+		UShooterBotThinkScheduler* ThinkScheduler = GetWorld()->GetSubsystem<UShooterBotThinkScheduler>();
+		const float ApplyDelay = ThinkScheduler ? ThinkScheduler->GetPhaseDelay(ThinkPhase) : 0.0f;
+		if (ApplyDelay > 0.0f)
+		{
+			GetWorldTimerManager().SetTimer(TimerHandle_ApplyLODLevel, this, &AShooterAIController::ApplyLODLevel, ApplyDelay, false);
+		}
+		else
+		{
+			ApplyLODLevel();
+		}
+	}
+}
+
+void AShooterAIController::StartBehavior()
+{
+	AShooterBot* Bot = Cast<AShooterBot>(GetPawn());
+	if (Bot && Bot->BotBehavior)
+	{
+		BehaviorComp->StartTree(*(Bot->BotBehavior));
+	}
+}
+
+void AShooterAIController::ApplyLODLevel()
+{
+	BehaviorComp->SetThrottleInterval(UShooterBotLODManager::GetBehaviorTickInterval(LODLevel));
+
+	const float MovementInterval = UShooterBotLODManager::GetMovementTickInterval(LODLevel);
+	if (GetPathFollowingComponent())
+	{
+		GetPathFollowingComponent()->SetComponentTickInterval(MovementInterval);
+	}
+
+	ACharacter* MyCharacter = Cast<ACharacter>(GetPawn());
+	if (MyCharacter && MyCharacter->GetCharacterMovement())
+	{
+		MyCharacter->GetCharacterMovement()->SetComponentTickInterval(MovementInterval);
+	}
+}
+
+void AShooterAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UShooterBotThinkScheduler* ThinkScheduler = GetWorld()->GetSubsystem<UShooterBotThinkScheduler>();
+	if (ThinkScheduler)
+	{
+		ThinkScheduler->ReleasePhase(ThinkPhase);
+	}
+	ThinkPhase = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AShooterAIController::Reset()
+{
+	// match restarts in place, the game mode respawns us when it starts
+	GetWorldTimerManager().ClearTimer(TimerHandle_Respawn);
+
+	Super::Reset();
+}
+
 void AShooterAIController::BeginInactiveState()
 {
 	Super::BeginInactiveState();
 
+	// died before our think phase came up, the next possess schedules a fresh start
+	GetWorldTimerManager().ClearTimer(TimerHandle_StartBehavior);
+
 	AGameStateBase const* const GameState = GetWorld()->GetGameState();
 
 	const float MinRespawnDelay = GameState ? GameState->GetPlayerRespawnDelay(this) : 1.0f;
@@ -61,9 +177,26 @@ void AShooterAIController::BeginInactiveState()
 
 void AShooterAIController::Respawn()
 {
+	if (bCrowdBot)
+	{
+		// crowd bots respawn as data
+		UShooterCrowdManager* CrowdManager = GetWorld()->GetSubsystem<UShooterCrowdManager>();
+		if (CrowdManager)
+		{
+			CrowdManager->OnPromotedBotDied(this);
+		}
+		return;
+	}
+
 	GetWorld()->GetAuthGameMode()->RestartPlayer(this);
 }
 
+void AShooterAIController::SetCrowdEntityIndex(int32 NewIndex)
+{
+	CrowdEntityIndex = NewIndex;
+	bCrowdBot = true;
+}
+
 void AShooterAIController::FindClosestEnemy()
 {
 	APawn* MyBot = GetPawn();
@@ -72,26 +205,20 @@ void AShooterAIController::FindClosestEnemy()
 		return;
 	}
 
-	const FVector MyLoc = MyBot->GetActorLocation();
-	float BestDistSq = MAX_FLT;
-	AShooterCharacter* BestPawn = NULL;
-
-	for (AShooterCharacter* TestPawn : TActorRange<AShooterCharacter>(GetWorld()))
+	UShooterPawnRegistry* PawnRegistry = GetWorld()->GetSubsystem<UShooterPawnRegistry>();
+	if (PawnRegistry == NULL)
 	{
-		if (TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
-		{
-			const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-			if (DistSq < BestDistSq)
-			{
-				BestDistSq = DistSq;
-				BestPawn = TestPawn;
-			}
-		}
+		return;
 	}
 
-	if (BestPawn)
+	const int32 BestIdx = PawnRegistry->FindNearestHostile(MyBot->GetActorLocation(), GetHostileQueryExcludeTeam(), MAX_FLT, [&](int32 Idx)
+	{
+		return PawnRegistry->GetCharacter(Idx)->IsEnemyFor(this);
+	});
+
+	if (BestIdx != INDEX_NONE)
 	{
-		SetEnemy(BestPawn);
+		SetEnemy(PawnRegistry->GetCharacter(BestIdx));
 	}
 }
 
@@ -99,57 +226,67 @@ bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEne
 {
 	bool bGotEnemy = false;
 	APawn* MyBot = GetPawn();
-	if (MyBot != NULL)
+	UShooterPawnRegistry* PawnRegistry = GetWorld()->GetSubsystem<UShooterPawnRegistry>();
+	if (MyBot != NULL && PawnRegistry != NULL)
 	{
-		const FVector MyLoc = MyBot->GetActorLocation();
-		float BestDistSq = MAX_FLT;
-		AShooterCharacter* BestPawn = NULL;
-
-		for (AShooterCharacter* TestPawn : TActorRange<AShooterCharacter>(GetWorld()))
+		// closest first, so we can stop tracing at the first enemy in sight; grow K only when the closest ones are all hidden
+		const int32 ExcludeTeamNum = GetHostileQueryExcludeTeam();
+		TArray<int32> EnemyIndices;
+		int32 NumChecked = 0;
+		for (int32 K = 4; !bGotEnemy; K *= 2)
 		{
-			if (TestPawn != ExcludeEnemy && TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
+			PawnRegistry->FindKNearestHostile(MyBot->GetActorLocation(), ExcludeTeamNum, K, MAX_FLT, [&](int32 Idx)
+			{
+				AShooterCharacter* TestPawn = PawnRegistry->GetCharacter(Idx);
+				return TestPawn != ExcludeEnemy && TestPawn->IsEnemyFor(this);
+			}, EnemyIndices);
+
+			for (int32 i = NumChecked; i < EnemyIndices.Num(); i++)
 			{
+				AShooterCharacter* TestPawn = PawnRegistry->GetCharacter(EnemyIndices[i]);
 				if (HasWeaponLOSToEnemy(TestPawn, true) == true)
 				{
-					const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-					if (DistSq < BestDistSq)
-					{
-						BestDistSq = DistSq;
-						BestPawn = TestPawn;
-					}
+					SetEnemy(TestPawn);
+					bGotEnemy = true;
+					break;
 				}
 			}
-		}
-		if (BestPawn)
-		{
-			SetEnemy(BestPawn);
-			bGotEnemy = true;
+
+			if (EnemyIndices.Num() < K)
+			{
+				break;
+			}
+			NumChecked = EnemyIndices.Num();
 		}
 	}
 	return bGotEnemy;
 }
 
+int32 AShooterAIController::GetHostileQueryExcludeTeam() const
+{
+	// free for all puts everyone on one team, the IsEnemyFor filter then drops ourselves
+	AShooterGameState* const MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	AShooterPlayerState* const MyPlayerState = Cast<AShooterPlayerState>(PlayerState);
+	if (MyGameState && MyGameState->NumTeams > 1 && MyPlayerState)
+	{
+		return MyPlayerState->GetTeamNum();
+	}
+
+	return INDEX_NONE;
+}
+
 bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy) const
 {
-	
-	AShooterBot* MyBot = Cast<AShooterBot>(GetPawn());
+	UShooterBotPerception* Perception = GetWorld()->GetSubsystem<UShooterBotPerception>();
 
 	bool bHasLOS = false;
-	// Perform trace to retrieve hit info
-	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AIWeaponLosTrace), true, GetPawn());
-
-	TraceParams.bReturnPhysicalMaterial = true;	
-	FVector StartLocation = MyBot->GetActorLocation();	
-	StartLocation.Z += GetPawn()->BaseEyeHeight; //look from eyes
-	
-	FHitResult Hit(ForceInit);
-	const FVector EndLocation = InEnemyActor->GetActorLocation();
-	GetWorld()->LineTraceSingleByChannel(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
-	if (Hit.bBlockingHit == true)
+	// Read the last batched trace for this pair, a refresh is queued when it gets old
+	FBotLOSResult LOS;
+	if (Perception && Perception->GetLOS(GetPawn(), InEnemyActor, LOS, UShooterBotLODManager::GetPerceptionAgeScale(LODLevel)) && LOS.bBlockingHit == true)
 	{
 		// Theres a blocking hit - check if its our enemy actor
-		AActor* HitActor = Hit.GetActor();
-		if (Hit.GetActor() != NULL)
+		AActor* HitActor = LOS.HitActor.Get();
+		if (HitActor != NULL)
 		{
 			if (HitActor == InEnemyActor)
 			{
@@ -175,8 +312,6 @@ bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool
 		}
 	}
 
-	
-
 	return bHasLOS;
 }
 
@@ -193,7 +328,7 @@ void AShooterAIController::ShootEnemy()
 	AShooterCharacter* Enemy = GetEnemy();
 	if ( Enemy && ( Enemy->IsAlive() )&& (MyWeapon->GetCurrentAmmo() > 0) && ( MyWeapon->CanFire() == true ) )
 	{
-		if (LineOfSightTo(Enemy, MyBot->GetActorLocation()))
+		if (HasWeaponLOSToEnemy(Enemy, true))
 		{
 			bCanShoot = true;
 		}
@@ -274,6 +409,10 @@ void AShooterAIController::GameHasEnded(AActor* EndGameFocus, bool bIsWinner)
 	// Cancel the repsawn timer
 	GetWorldTimerManager().ClearTimer(TimerHandle_Respawn);
 
+	// Cancel deferred behavior start and LOD change, the tree must stay stopped
+	GetWorldTimerManager().ClearTimer(TimerHandle_StartBehavior);
+	GetWorldTimerManager().ClearTimer(TimerHandle_ApplyLODLevel);
+
 	// Clear any enemy
 	SetEnemy(NULL);
 
@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterBehaviorTreeComponent.h"
+
+UShooterBehaviorTreeComponent::UShooterBehaviorTreeComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	ThrottleInterval = 0.0f;
+	ThrottledDeltaTime = 0.0f;
+}
+
+void UShooterBehaviorTreeComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	// execution requests in between reset the tree's interval to the next frame, hold them until the throttle allows
+	ThrottledDeltaTime += DeltaTime;
+	if (ThrottledDeltaTime < ThrottleInterval)
+	{
+		return;
+	}
+
+	const float TreeDeltaTime = ThrottledDeltaTime;
+	ThrottledDeltaTime = 0.0f;
+
+	Super::TickComponent(TreeDeltaTime, TickType, ThisTickFunction);
+
+	// the tree has scheduled its next update from what its nodes need, never let it come sooner than the throttle
+	if (ThrottleInterval > 0.0f && IsComponentTickEnabled() && GetComponentTickInterval() < ThrottleInterval)
+	{
+		SetComponentTickIntervalAndCooldown(ThrottleInterval);
+	}
+}
+
+void UShooterBehaviorTreeComponent::SetThrottleInterval(float NewThrottleInterval)
+{
+	ThrottleInterval = FMath::Max(NewThrottleInterval, 0.0f);
+
+	// start counting now, so an interval applied in the bot's think phase keeps later updates in it
+	ThrottledDeltaTime = 0.0f;
+	if (ThrottleInterval > 0.0f && IsComponentTickEnabled())
+	{
+		SetComponentTickIntervalAndCooldown(ThrottleInterval);
+	}
+}
@@ -0,0 +1,195 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterBotLODManager.h"
+#include "Bots/ShooterAIController.h"
+
+static int32 BotLODEnabled = 1;
+FAutoConsoleVariableRef CVarBotLODEnabled(
+	TEXT("p.BotLODEnabled"),
+	BotLODEnabled,
+	TEXT("Reduce update rates of bots far from every human viewer"),
+	ECVF_Default);
+
+static float BotLODMediumDistance = 3000.0f;
+FAutoConsoleVariableRef CVarBotLODMediumDistance(
+	TEXT("p.BotLODMediumDistance"),
+	BotLODMediumDistance,
+	TEXT("Distance to closest human viewer beyond which bots use medium LOD"),
+	ECVF_Default);
+
+static float BotLODFarDistance = 8000.0f;
+FAutoConsoleVariableRef CVarBotLODFarDistance(
+	TEXT("p.BotLODFarDistance"),
+	BotLODFarDistance,
+	TEXT("Distance to closest human viewer beyond which bots use far LOD"),
+	ECVF_Default);
+
+static float BotLODMediumBehaviorInterval = 0.1f;
+FAutoConsoleVariableRef CVarBotLODMediumBehaviorInterval(
+	TEXT("p.BotLODMediumBehaviorInterval"),
+	BotLODMediumBehaviorInterval,
+	TEXT("Minimum time (s) between behavior tree updates of medium LOD bots"),
+	ECVF_Default);
+
+static float BotLODFarBehaviorInterval = 0.25f;
+FAutoConsoleVariableRef CVarBotLODFarBehaviorInterval(
+	TEXT("p.BotLODFarBehaviorInterval"),
+	BotLODFarBehaviorInterval,
+	TEXT("Minimum time (s) between behavior tree updates of far LOD bots"),
+	ECVF_Default);
+
+static float BotLODFarMovementInterval = 0.05f;
+FAutoConsoleVariableRef CVarBotLODFarMovementInterval(
+	TEXT("p.BotLODFarMovementInterval"),
+	BotLODFarMovementInterval,
+	TEXT("Movement and path following tick interval (s) of far LOD bots"),
+	ECVF_Default);
+
+static float BotLODMediumPerceptionScale = 2.0f;
+FAutoConsoleVariableRef CVarBotLODMediumPerceptionScale(
+	TEXT("p.BotLODMediumPerceptionScale"),
+	BotLODMediumPerceptionScale,
+	TEXT("Multiplier of p.BotLOSMaxAge for medium LOD bots"),
+	ECVF_Default);
+
+static float BotLODFarPerceptionScale = 5.0f;
+FAutoConsoleVariableRef CVarBotLODFarPerceptionScale(
+	TEXT("p.BotLODFarPerceptionScale"),
+	BotLODFarPerceptionScale,
+	TEXT("Multiplier of p.BotLOSMaxAge for far LOD bots"),
+	ECVF_Default);
+
+/** how often LODs are reassigned */
+static const float BotLODUpdateInterval = 0.5f;
+
+/** bots have to get this much further than a threshold before dropping detail */
+static const float BotLODHysteresis = 1.1f;
+
+void UShooterBotLODManager::Deinitialize()
+{
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_UpdateLODs);
+	}
+
+	Bots.Reset();
+
+	Super::Deinitialize();
+}
+
+void UShooterBotLODManager::RegisterBot(AShooterAIController* Bot)
+{
+	if (Bot == NULL)
+	{
+		return;
+	}
+
+	Bots.AddUnique(Bot);
+
+	if (!GetWorld()->GetTimerManager().IsTimerActive(TimerHandle_UpdateLODs))
+	{
+		GetWorld()->GetTimerManager().SetTimer(TimerHandle_UpdateLODs, this, &UShooterBotLODManager::UpdateLODs, BotLODUpdateInterval, true);
+	}
+}
+
+void UShooterBotLODManager::UnregisterBot(AShooterAIController* Bot)
+{
+	Bots.RemoveSingleSwap(Bot);
+}
+
+float UShooterBotLODManager::GetBehaviorTickInterval(EShooterBotLOD::Type LODLevel)
+{
+	switch (LODLevel)
+	{
+		case EShooterBotLOD::Medium:	return BotLODMediumBehaviorInterval;
+		case EShooterBotLOD::Far:		return BotLODFarBehaviorInterval;
+		default:			return 0.0f;
+	}
+}
+
+float UShooterBotLODManager::GetMovementTickInterval(EShooterBotLOD::Type LODLevel)
+{
+	return (LODLevel >= EShooterBotLOD::Far) ? BotLODFarMovementInterval : 0.0f;
+}
+
+float UShooterBotLODManager::GetPerceptionAgeScale(EShooterBotLOD::Type LODLevel)
+{
+	switch (LODLevel)
+	{
+		case EShooterBotLOD::Medium:	return FMath::Max(BotLODMediumPerceptionScale, 1.0f);
+		case EShooterBotLOD::Far:		return FMath::Max(BotLODFarPerceptionScale, 1.0f);
+		default:			return 1.0f;
+	}
+}
+
+EShooterBotLOD::Type UShooterBotLODManager::GetLODForDistance(float DistSq, EShooterBotLOD::Type CurrentLOD)
+{
+	const float MediumScale = (CurrentLOD >= EShooterBotLOD::Medium) ? 1.0f : BotLODHysteresis;
+	const float FarScale = (CurrentLOD >= EShooterBotLOD::Far) ? 1.0f : BotLODHysteresis;
+
+	if (DistSq > FMath::Square(BotLODFarDistance * FarScale))
+	{
+		return EShooterBotLOD::Far;
+	}
+	if (DistSq > FMath::Square(BotLODMediumDistance * MediumScale))
+	{
+		return EShooterBotLOD::Medium;
+	}
+	return EShooterBotLOD::Near;
+}
+
+void UShooterBotLODManager::UpdateLODs()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterBotLODManager_UpdateLODs);
+
+	Bots.RemoveAllSwap([](const TWeakObjectPtr<AShooterAIController>& Bot) { return !Bot.IsValid(); });
+
+	if (Bots.Num() == 0)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_UpdateLODs);
+		return;
+	}
+
+	// human viewers, spectators included
+	TArray<FVector> ViewLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (PC)
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+
+	// nobody to save detail for, e.g. headless load tests, measure bots at full fidelity
+	const bool bUseLOD = BotLODEnabled && ViewLocations.Num() > 0;
+
+	for (const TWeakObjectPtr<AShooterAIController>& Bot : Bots)
+	{
+		const APawn* BotPawn = Bot->GetPawn();
+		if (BotPawn == NULL)
+		{
+			continue;
+		}
+
+		EShooterBotLOD::Type NewLOD = EShooterBotLOD::Near;
+		if (bUseLOD)
+		{
+			const FVector BotLocation = BotPawn->GetActorLocation();
+			float BestDistSq = MAX_FLT;
+			for (const FVector& ViewLocation : ViewLocations)
+			{
+				BestDistSq = FMath::Min(BestDistSq, FVector::DistSquared(BotLocation, ViewLocation));
+			}
+
+			NewLOD = GetLODForDistance(BestDistSq, Bot->GetLODLevel());
+		}
+
+		Bot->SetLODLevel(NewLOD);
+	}
+}
@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterBotPerception.h"
+
+static int32 BotLOSTracesPerFrame = 32;
+FAutoConsoleVariableRef CVarBotLOSTracesPerFrame(
+	TEXT("p.BotLOSTracesPerFrame"),
+	BotLOSTracesPerFrame,
+	TEXT("Max number of async bot line of sight traces issued per frame"),
+	ECVF_Default);
+
+static float BotLOSMaxAge = 0.2f;
+FAutoConsoleVariableRef CVarBotLOSMaxAge(
+	TEXT("p.BotLOSMaxAge"),
+	BotLOSMaxAge,
+	TEXT("Age (s) after which a cached bot line of sight result is refreshed"),
+	ECVF_Default);
+
+/** pairs not asked about for this long are forgotten */
+static const float BotLOSIdleTime = 2.0f;
+
+void UShooterBotPerception::Deinitialize()
+{
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearAllTimersForObject(this);
+	}
+
+	Entries.Reset();
+	RequestQueue.Reset();
+	InFlight.Reset();
+	bFlushScheduled = false;
+
+	Super::Deinitialize();
+}
+
+bool UShooterBotPerception::GetLOS(APawn* Viewer, AActor* Target, FBotLOSResult& OutResult, float MaxAgeScale)
+{
+	if (Viewer == NULL || Target == NULL)
+	{
+		return false;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	FLOSKey Key;
+	Key.Viewer = Viewer;
+	Key.Target = Target;
+
+	FLOSEntry& Entry = Entries.FindOrAdd(Key);
+	Entry.LastRequestTime = Now;
+
+	const bool bStale = !Entry.bHasResult || (Now - Entry.Result.Timestamp) > BotLOSMaxAge * MaxAgeScale;
+	if (bStale && !Entry.bPending)
+	{
+		Entry.bPending = true;
+		RequestQueue.Add(Key);
+
+		if (!bFlushScheduled)
+		{
+			bFlushScheduled = true;
+			GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UShooterBotPerception::FlushRequests);
+		}
+	}
+
+	OutResult = Entry.Result;
+	return Entry.bHasResult;
+}
+
+void UShooterBotPerception::FlushRequests()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterBotPerception_Flush);
+
+	bFlushScheduled = false;
+
+	UWorld* World = GetWorld();
+	const float Now = World->GetTimeSeconds();
+
+	if (!TraceDelegate.IsBound())
+	{
+		TraceDelegate.BindUObject(this, &UShooterBotPerception::OnTraceCompleted);
+	}
+
+	int32 NumIssued = 0;
+	int32 NumConsumed = 0;
+	const int32 MaxTraces = FMath::Max(BotLOSTracesPerFrame, 1);
+	for (; NumConsumed < RequestQueue.Num() && NumIssued < MaxTraces; NumConsumed++)
+	{
+		const FLOSKey& Key = RequestQueue[NumConsumed];
+		APawn* Viewer = Key.Viewer.Get();
+		AActor* Target = Key.Target.Get();
+		if (Viewer == NULL || Target == NULL)
+		{
+			Entries.Remove(Key);
+			continue;
+		}
+
+		FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AIWeaponLosTrace), true, Viewer);
+
+		FVector StartLocation = Viewer->GetActorLocation();
+		StartLocation.Z += Viewer->BaseEyeHeight; //look from eyes
+
+		const uint32 TraceId = NextTraceId++;
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, StartLocation, Target->GetActorLocation(), COLLISION_WEAPON,
+			TraceParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, TraceId);
+		InFlight.Add(TraceId, Key);
+		NumIssued++;
+	}
+	RequestQueue.RemoveAt(0, NumConsumed, false);
+
+	if (RequestQueue.Num() > 0)
+	{
+		bFlushScheduled = true;
+		World->GetTimerManager().SetTimerForNextTick(this, &UShooterBotPerception::FlushRequests);
+	}
+
+	if (Now - LastEvictTime > BotLOSIdleTime)
+	{
+		EvictIdleEntries(Now);
+	}
+}
+
+void UShooterBotPerception::OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	FLOSKey Key;
+	if (!InFlight.RemoveAndCopyValue(Datum.UserData, Key))
+	{
+		return;
+	}
+
+	FLOSEntry* Entry = Entries.Find(Key);
+	if (Entry == NULL)
+	{
+		return;
+	}
+
+	const FHitResult* Hit = Datum.OutHits.FindByPredicate([](const FHitResult& TestHit) { return TestHit.bBlockingHit; });
+
+	Entry->Result.bBlockingHit = (Hit != NULL);
+	Entry->Result.HitActor = Hit ? Hit->GetActor() : NULL;
+	Entry->Result.Timestamp = GetWorld()->GetTimeSeconds();
+	Entry->bHasResult = true;
+	Entry->bPending = false;
+}
+
+void UShooterBotPerception::EvictIdleEntries(float Now)
+{
+	LastEvictTime = Now;
+
+	// entries with a trace in flight stay, dropping them would queue a duplicate trace on the next request
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().bPending && (Now - It.Value().LastRequestTime) > BotLOSIdleTime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
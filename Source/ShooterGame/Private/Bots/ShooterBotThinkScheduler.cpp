@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterBotThinkScheduler.h"
+
+static int32 BotThinkPhases = 8;
+FAutoConsoleVariableRef CVarBotThinkPhases(
+	TEXT("p.BotThinkPhases"),
+	BotThinkPhases,
+	TEXT("Number of phase slots bot thinking is spread over, 1 or less disables staggering"),
+	ECVF_Default);
+
+static float BotThinkPeriod = 0.25f;
+FAutoConsoleVariableRef CVarBotThinkPeriod(
+	TEXT("p.BotThinkPeriod"),
+	BotThinkPeriod,
+	TEXT("Time (s) covered by all bot think phase slots, 0 disables staggering"),
+	ECVF_Default);
+
+int32 UShooterBotThinkScheduler::AcquirePhase()
+{
+	if (BotThinkPhases <= 1 || BotThinkPeriod <= 0.0f)
+	{
+		return INDEX_NONE;
+	}
+
+	RemapPhaseLoad();
+
+	int32 BestPhase = 0;
+	for (int32 i = 1; i < PhaseLoad.Num(); i++)
+	{
+		if (PhaseLoad[i] < PhaseLoad[BestPhase])
+		{
+			BestPhase = i;
+		}
+	}
+
+	PhaseLoad[BestPhase]++;
+	return BestPhase;
+}
+
+void UShooterBotThinkScheduler::ReleasePhase(int32 Phase)
+{
+	if (Phase == INDEX_NONE)
+	{
+		return;
+	}
+
+	RemapPhaseLoad();
+
+	const int32 Slot = Phase % PhaseLoad.Num();
+	if (PhaseLoad[Slot] > 0)
+	{
+		PhaseLoad[Slot]--;
+	}
+}
+
+void UShooterBotThinkScheduler::RemapPhaseLoad()
+{
+	const int32 NumPhases = FMath::Max(BotThinkPhases, 1);
+	if (PhaseLoad.Num() == NumPhases)
+	{
+		return;
+	}
+
+	// bots keep the slot they were given, which lands on Phase % NumPhases after p.BotThinkPhases changes
+	TArray<int32> OldLoad = MoveTemp(PhaseLoad);
+	PhaseLoad.SetNumZeroed(NumPhases);
+	for (int32 i = 0; i < OldLoad.Num(); i++)
+	{
+		PhaseLoad[i % NumPhases] += OldLoad[i];
+	}
+}
+
+float UShooterBotThinkScheduler::GetPhaseDelay(int32 Phase) const
+{
+	if (Phase == INDEX_NONE || BotThinkPhases <= 1 || BotThinkPeriod <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	// slots are anchored to world time, so bots that respawn later still land in theirs
+	const float PhaseStart = BotThinkPeriod * (Phase % BotThinkPhases) / BotThinkPhases;
+	float Delay = FMath::Fmod(PhaseStart - GetWorld()->GetTimeSeconds(), BotThinkPeriod);
+	if (Delay < 0.0f)
+	{
+		Delay += BotThinkPeriod;
+	}
+
+	return Delay;
+}
@@ -0,0 +1,436 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterCrowdManager.h"
+#include "Bots/ShooterAIController.h"
+#include "Online/ShooterPlayerState.h"
+#include "NavigationSystem.h"
+
+static float CrowdPromoteDistance = 5000.0f;
+FAutoConsoleVariableRef CVarCrowdPromoteDistance(
+	TEXT("p.CrowdPromoteDistance"),
+	CrowdPromoteDistance,
+	TEXT("Distance to closest human viewer below which crowd bots become full bots"),
+	ECVF_Default);
+
+static int32 CrowdMaxPromoted = 32;
+FAutoConsoleVariableRef CVarCrowdMaxPromoted(
+	TEXT("p.CrowdMaxPromoted"),
+	CrowdMaxPromoted,
+	TEXT("Max number of crowd bots promoted to full bots at once"),
+	ECVF_Default);
+
+static float CrowdEngageRange = 3000.0f;
+FAutoConsoleVariableRef CVarCrowdEngageRange(
+	TEXT("p.CrowdEngageRange"),
+	CrowdEngageRange,
+	TEXT("Distance at which simulated crowd bots fight each other"),
+	ECVF_Default);
+
+static int32 CrowdNavQueriesPerUpdate = 16;
+FAutoConsoleVariableRef CVarCrowdNavQueriesPerUpdate(
+	TEXT("p.CrowdNavQueriesPerUpdate"),
+	CrowdNavQueriesPerUpdate,
+	TEXT("Max number of new movement goals picked per crowd update"),
+	ECVF_Default);
+
+/** how often processors run */
+static const float CrowdUpdateInterval = 0.1f;
+
+/** promoted bots have to get this much further than CrowdPromoteDistance before demotion */
+static const float CrowdDemoteHysteresis = 1.2f;
+
+/** simulated movement */
+static const float CrowdMoveSpeed = 400.0f;
+static const float CrowdGoalRadius = 3000.0f;
+static const float CrowdGoalAcceptance = 50.0f;
+
+/** simulated combat */
+static const float CrowdMaxHealth = 100.0f;
+static const float CrowdFireInterval = 0.5f;
+static const float CrowdHitChance = 0.3f;
+static const float CrowdHitDamage = 10.0f;
+static const float CrowdRespawnDelay = 5.0f;
+
+/** offset from navmesh point to pawn spawn location */
+static const float CrowdSpawnHeight = 90.0f;
+
+/** offset added to entity index for bot names */
+static const int32 CrowdBotNumOffset = 1000;
+
+void UShooterCrowdManager::Deinitialize()
+{
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_UpdateCrowd);
+	}
+
+	Positions.Reset();
+	Goals.Reset();
+	TeamNums.Reset();
+	Healths.Reset();
+	FireCooldowns.Reset();
+	RespawnTimes.Reset();
+	Targets.Reset();
+	Controllers.Reset();
+	ControllerPool.Reset();
+	CellHeads.Reset();
+	NumPromoted = 0;
+
+	Super::Deinitialize();
+}
+
+void UShooterCrowdManager::SpawnCrowd(int32 NumEntities)
+{
+	UWorld* World = GetWorld();
+
+	SpawnLocations.Reset();
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		SpawnLocations.Add(It->GetActorLocation());
+	}
+
+	if (NumEntities <= 0 || SpawnLocations.Num() == 0 || Positions.Num() > 0)
+	{
+		return;
+	}
+
+	const AShooterGameState* GameState = World->GetGameState<AShooterGameState>();
+	const int32 NumTeams = GameState ? GameState->NumTeams : 0;
+
+	Positions.SetNumUninitialized(NumEntities);
+	Goals.SetNumUninitialized(NumEntities);
+	TeamNums.SetNumUninitialized(NumEntities);
+	Healths.SetNumUninitialized(NumEntities);
+	FireCooldowns.SetNumZeroed(NumEntities);
+	RespawnTimes.SetNumZeroed(NumEntities);
+	Targets.Init(INDEX_NONE, NumEntities);
+	Controllers.Init(NULL, NumEntities);
+
+	for (int32 i = 0; i < NumEntities; i++)
+	{
+		Positions[i] = SpawnLocations[FMath::RandHelper(SpawnLocations.Num())];
+		Goals[i] = Positions[i];
+		TeamNums[i] = (NumTeams > 1) ? (i % NumTeams) : INDEX_NONE;
+		Healths[i] = CrowdMaxHealth;
+	}
+
+	World->GetTimerManager().SetTimer(TimerHandle_UpdateCrowd, this, &UShooterCrowdManager::UpdateCrowd, CrowdUpdateInterval, true);
+}
+
+void UShooterCrowdManager::ResetCrowd()
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	for (int32 i = 0; i < Positions.Num(); i++)
+	{
+		if (Controllers[i])
+		{
+			DemoteEntity(i);
+		}
+
+		// picked up by ProcessRespawns on next update
+		Healths[i] = 0.0f;
+		RespawnTimes[i] = Now;
+	}
+}
+
+void UShooterCrowdManager::UpdateCrowd()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterCrowdManager_Update);
+
+	AGameMode* GameMode = GetWorld()->GetAuthGameMode<AGameMode>();
+	if (GameMode == NULL || !GameMode->IsMatchInProgress())
+	{
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	ProcessRespawns(Now);
+	ProcessSpatialHash();
+	ProcessTargeting();
+	ProcessFiring(CrowdUpdateInterval, Now);
+	ProcessMovement(CrowdUpdateInterval);
+	ProcessLOD();
+}
+
+bool UShooterCrowdManager::IsHostile(int32 IndexA, int32 IndexB) const
+{
+	return IndexA != IndexB && (TeamNums[IndexA] == INDEX_NONE || TeamNums[IndexA] != TeamNums[IndexB]);
+}
+
+FIntPoint UShooterCrowdManager::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UShooterCrowdManager::ProcessRespawns(float Now)
+{
+	for (int32 i = 0; i < Positions.Num(); i++)
+	{
+		if (Healths[i] <= 0.0f && Controllers[i] == NULL && Now >= RespawnTimes[i])
+		{
+			Positions[i] = SpawnLocations[FMath::RandHelper(SpawnLocations.Num())];
+			Goals[i] = Positions[i];
+			Healths[i] = CrowdMaxHealth;
+			FireCooldowns[i] = 0.0f;
+			Targets[i] = INDEX_NONE;
+		}
+	}
+}
+
+void UShooterCrowdManager::ProcessSpatialHash()
+{
+	CellSize = FMath::Max(CrowdEngageRange, 100.0f);
+	CellHeads.Reset();
+	NextInCell.SetNumUninitialized(Positions.Num(), false);
+
+	for (int32 i = 0; i < Positions.Num(); i++)
+	{
+		if (IsSimulated(i))
+		{
+			int32& Head = CellHeads.FindOrAdd(GetCell(Positions[i]), INDEX_NONE);
+			NextInCell[i] = Head;
+			Head = i;
+		}
+	}
+}
+
+void UShooterCrowdManager::ProcessTargeting()
+{
+	const float RangeSq = FMath::Square(CrowdEngageRange);
+
+	for (int32 i = 0; i < Positions.Num(); i++)
+	{
+		Targets[i] = INDEX_NONE;
+		if (!IsSimulated(i))
+		{
+			continue;
+		}
+
+		// cell size is the engage range, so the 3x3 block around us covers it
+		const FIntPoint Cell = GetCell(Positions[i]);
+		float BestDistSq = RangeSq;
+		for (int32 Y = Cell.Y - 1; Y <= Cell.Y + 1; Y++)
+		{
+			for (int32 X = Cell.X - 1; X <= Cell.X + 1; X++)
+			{
+				const int32* Head = CellHeads.Find(FIntPoint(X, Y));
+				for (int32 Other = Head ? *Head : INDEX_NONE; Other != INDEX_NONE; Other = NextInCell[Other])
+				{
+					const float DistSq = FVector::DistSquared(Positions[i], Positions[Other]);
+					if (DistSq < BestDistSq && IsHostile(i, Other))
+					{
+						BestDistSq = DistSq;
+						Targets[i] = Other;
+					}
+				}
+			}
+		}
+	}
+}
+
+void UShooterCrowdManager::ProcessFiring(float DeltaTime, float Now)
+{
+	for (int32 i = 0; i < Positions.Num(); i++)
+	{
+		FireCooldowns[i] = FMath::Max(FireCooldowns[i] - DeltaTime, 0.0f);
+
+		const int32 Target = Targets[i];
+		if (Target == INDEX_NONE || FireCooldowns[i] > 0.0f || !IsSimulated(i) || !IsSimulated(Target))
+		{
+			continue;
+		}
+
+		FireCooldowns[i] = CrowdFireInterval;
+		if (FMath::FRand() < CrowdHitChance)
+		{
+			Healths[Target] -= CrowdHitDamage;
+			if (Healths[Target] <= 0.0f)
+			{
+				RespawnTimes[Target] = Now + CrowdRespawnDelay;
+			}
+		}
+	}
+}
+
+void UShooterCrowdManager::ProcessMovement(float DeltaTime)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	int32 NavQueriesLeft = CrowdNavQueriesPerUpdate;
+	const float Step = CrowdMoveSpeed * DeltaTime;
+
+	for (int32 i = 0; i < Positions.Num(); i++)
+	{
+		// stand still while fighting
+		if (!IsSimulated(i) || Targets[i] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FVector ToGoal = Goals[i] - Positions[i];
+		const float DistToGoal = ToGoal.Size();
+		if (DistToGoal > CrowdGoalAcceptance)
+		{
+			Positions[i] += ToGoal * (FMath::Min(Step, DistToGoal) / DistToGoal);
+		}
+		else if (NavSys && NavQueriesLeft > 0)
+		{
+			// straight lines between reachable points are good enough where nobody is looking
+			NavQueriesLeft--;
+			FNavLocation NewGoal;
+			if (NavSys->GetRandomReachablePointInRadius(Positions[i], CrowdGoalRadius, NewGoal))
+			{
+				Goals[i] = NewGoal.Location;
+			}
+		}
+	}
+}
+
+void UShooterCrowdManager::ProcessLOD()
+{
+	TArray<FVector> ViewLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (PC)
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+
+	const float PromoteDistSq = FMath::Square(CrowdPromoteDistance);
+	const float DemoteDistSq = FMath::Square(CrowdPromoteDistance * CrowdDemoteHysteresis);
+
+	for (int32 i = 0; i < Positions.Num(); i++)
+	{
+		const bool bPromoted = (Controllers[i] != NULL);
+		if (!bPromoted && !IsSimulated(i))
+		{
+			continue;
+		}
+
+		const APawn* BotPawn = bPromoted ? Controllers[i]->GetPawn() : NULL;
+		if (bPromoted && BotPawn == NULL)
+		{
+			// dead, waiting for OnPromotedBotDied
+			continue;
+		}
+
+		const FVector Location = BotPawn ? BotPawn->GetActorLocation() : Positions[i];
+		float BestDistSq = MAX_FLT;
+		for (const FVector& ViewLocation : ViewLocations)
+		{
+			BestDistSq = FMath::Min(BestDistSq, FVector::DistSquared(Location, ViewLocation));
+		}
+
+		if (!bPromoted && BestDistSq < PromoteDistSq && NumPromoted < CrowdMaxPromoted)
+		{
+			PromoteEntity(i);
+		}
+		else if (bPromoted && BestDistSq > DemoteDistSq)
+		{
+			DemoteEntity(i);
+		}
+	}
+}
+
+void UShooterCrowdManager::PromoteEntity(int32 Index)
+{
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (GameMode == NULL)
+	{
+		return;
+	}
+
+	AShooterAIController* Bot = NULL;
+	if (ControllerPool.Num() > 0)
+	{
+		Bot = ControllerPool.Pop(false);
+		GameMode->InitBotPlayerState(Bot, CrowdBotNumOffset + Index);
+	}
+	else
+	{
+		Bot = GameMode->CreateBot(CrowdBotNumOffset + Index);
+	}
+
+	if (Bot == NULL)
+	{
+		return;
+	}
+
+	Bot->SetCrowdEntityIndex(Index);
+
+	AShooterPlayerState* BotPlayerState = Cast<AShooterPlayerState>(Bot->PlayerState);
+	if (BotPlayerState && TeamNums[Index] != INDEX_NONE)
+	{
+		BotPlayerState->SetTeamNum(TeamNums[Index]);
+	}
+
+	const FVector ToGoal = Goals[Index] - Positions[Index];
+	GameMode->RestartPlayerAtTransform(Bot, FTransform(ToGoal.Rotation(), Positions[Index] + FVector(0.0f, 0.0f, CrowdSpawnHeight)));
+
+	AShooterCharacter* BotPawn = Cast<AShooterCharacter>(Bot->GetPawn());
+	if (BotPawn == NULL)
+	{
+		// blocked spawn, try again next update
+		ReleaseController(Bot);
+		return;
+	}
+
+	BotPawn->Health = FMath::Min(Healths[Index], (float)BotPawn->GetMaxHealth());
+	Controllers[Index] = Bot;
+	NumPromoted++;
+}
+
+void UShooterCrowdManager::DemoteEntity(int32 Index)
+{
+	AShooterAIController* Bot = Controllers[Index];
+	AShooterCharacter* BotPawn = Cast<AShooterCharacter>(Bot->GetPawn());
+	if (BotPawn)
+	{
+		Positions[Index] = BotPawn->GetActorLocation() - FVector(0.0f, 0.0f, CrowdSpawnHeight);
+		Healths[Index] = BotPawn->Health;
+
+		// unpossess first so the controller doesn't go inactive and schedule a respawn
+		Bot->UnPossess();
+		BotPawn->Destroy();
+	}
+
+	Goals[Index] = Positions[Index];
+	Targets[Index] = INDEX_NONE;
+
+	ReleaseController(Bot);
+	Controllers[Index] = NULL;
+	NumPromoted--;
+}
+
+void UShooterCrowdManager::ReleaseController(AShooterAIController* Bot)
+{
+	Bot->SetCrowdEntityIndex(INDEX_NONE);
+
+	// a new player state is created on next promotion, nothing of this entity carries over
+	Bot->CleanupPlayerState();
+	ControllerPool.Add(Bot);
+}
+
+void UShooterCrowdManager::OnPromotedBotDied(AShooterAIController* Bot)
+{
+	const int32 Index = Bot ? Bot->GetCrowdEntityIndex() : INDEX_NONE;
+	if (!Controllers.IsValidIndex(Index) || Controllers[Index] != Bot)
+	{
+		return;
+	}
+
+	// back to data, respawns at a spawn point right away
+	Healths[Index] = 0.0f;
+	RespawnTimes[Index] = GetWorld()->GetTimeSeconds();
+
+	ReleaseController(Bot);
+	Controllers[Index] = NULL;
+	NumPromoted--;
+}
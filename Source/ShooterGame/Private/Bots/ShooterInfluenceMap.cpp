@@ -0,0 +1,210 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterInfluenceMap.h"
+#include "Player/ShooterPawnRegistry.h"
+#include "NavigationSystem.h"
+
+static float InfluenceCellSize = 500.0f;
+FAutoConsoleVariableRef CVarInfluenceCellSize(
+	TEXT("p.InfluenceCellSize"),
+	InfluenceCellSize,
+	TEXT("Cell size of the bot influence map, used when the map is created"),
+	ECVF_Default);
+
+static float InfluencePresenceHalfLife = 1.0f;
+FAutoConsoleVariableRef CVarInfluencePresenceHalfLife(
+	TEXT("p.InfluencePresenceHalfLife"),
+	InfluencePresenceHalfLife,
+	TEXT("Half life (s) of character presence in the bot influence map"),
+	ECVF_Default);
+
+static float InfluenceDeathHalfLife = 15.0f;
+FAutoConsoleVariableRef CVarInfluenceDeathHalfLife(
+	TEXT("p.InfluenceDeathHalfLife"),
+	InfluenceDeathHalfLife,
+	TEXT("Half life (s) of death heat in the bot influence map"),
+	ECVF_Default);
+
+/** how often presence is splatted and layers decay */
+static const float InfluenceUpdateInterval = 0.25f;
+
+/** grid size limit per axis */
+static const int32 InfluenceMaxCells = 512;
+
+/** grid extent used when there is no navmesh */
+static const float InfluenceDefaultExtent = 20000.0f;
+
+void UShooterInfluenceMap::Deinitialize()
+{
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_UpdateMap);
+	}
+
+	Layers.Empty();
+	NumTeamLayers = 0;
+
+	Super::Deinitialize();
+}
+
+void UShooterInfluenceMap::ConditionalInitialize()
+{
+	if (NumTeamLayers > 0)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	const AShooterGameState* GameState = World->GetGameState<AShooterGameState>();
+	NumTeamLayers = FMath::Max(GameState ? GameState->NumTeams : 0, 1);
+
+	FBox Bounds(ForceInit);
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : NULL;
+	if (NavData)
+	{
+		Bounds = NavData->GetBounds();
+	}
+	if (!Bounds.IsValid)
+	{
+		Bounds = FBox(FVector(-InfluenceDefaultExtent), FVector(InfluenceDefaultExtent));
+	}
+
+	CellSize = FMath::Max3(InfluenceCellSize, 100.0f, FMath::Max(Bounds.GetSize().X, Bounds.GetSize().Y) / InfluenceMaxCells);
+	GridOrigin = FVector2D(Bounds.Min.X, Bounds.Min.Y);
+	NumCells.X = FMath::Clamp(FMath::CeilToInt(Bounds.GetSize().X / CellSize), 1, InfluenceMaxCells);
+	NumCells.Y = FMath::Clamp(FMath::CeilToInt(Bounds.GetSize().Y / CellSize), 1, InfluenceMaxCells);
+
+	Layers.Init(0.0f, GetLayerOffset(NumTeamLayers + 1));
+
+	World->GetTimerManager().SetTimer(TimerHandle_UpdateMap, this, &UShooterInfluenceMap::UpdateMap, InfluenceUpdateInterval, true);
+}
+
+int32 UShooterInfluenceMap::GetCellIndex(const FVector& Location) const
+{
+	const int32 X = FMath::Clamp(FMath::FloorToInt((Location.X - GridOrigin.X) / CellSize), 0, NumCells.X - 1);
+	const int32 Y = FMath::Clamp(FMath::FloorToInt((Location.Y - GridOrigin.Y) / CellSize), 0, NumCells.Y - 1);
+	return Y * NumCells.X + X;
+}
+
+void UShooterInfluenceMap::Splat(int32 Layer, const FVector& Location, float Value)
+{
+	const int32 CellIdx = GetCellIndex(Location);
+	const int32 CX = CellIdx % NumCells.X;
+	const int32 CY = CellIdx / NumCells.X;
+	float* LayerData = Layers.GetData() + GetLayerOffset(Layer);
+
+	for (int32 Y = FMath::Max(CY - 1, 0); Y <= FMath::Min(CY + 1, NumCells.Y - 1); Y++)
+	{
+		for (int32 X = FMath::Max(CX - 1, 0); X <= FMath::Min(CX + 1, NumCells.X - 1); X++)
+		{
+			LayerData[Y * NumCells.X + X] += (X == CX && Y == CY) ? Value : Value * 0.5f;
+		}
+	}
+}
+
+float UShooterInfluenceMap::GetSelfPresence(const FVector& Location, const AActor* Querier) const
+{
+	if (Querier == NULL)
+	{
+		return 0.0f;
+	}
+
+	// same weights as Splat, presence of a moving character is spread out and only approximated
+	const int32 CellIdx = GetCellIndex(Location);
+	const int32 QuerierCellIdx = GetCellIndex(Querier->GetActorLocation());
+	const int32 DX = FMath::Abs(CellIdx % NumCells.X - QuerierCellIdx % NumCells.X);
+	const int32 DY = FMath::Abs(CellIdx / NumCells.X - QuerierCellIdx / NumCells.X);
+	if (DX == 0 && DY == 0)
+	{
+		return 1.0f;
+	}
+
+	return (DX <= 1 && DY <= 1) ? 0.5f : 0.0f;
+}
+
+void UShooterInfluenceMap::DecayLayers(int32 FirstLayer, int32 NumLayers, float Factor)
+{
+	// one flat contiguous loop, vectorized by the compiler
+	float* RESTRICT Data = Layers.GetData() + GetLayerOffset(FirstLayer);
+	const int32 Count = GetLayerOffset(NumLayers);
+	for (int32 i = 0; i < Count; i++)
+	{
+		Data[i] *= Factor;
+	}
+}
+
+void UShooterInfluenceMap::UpdateMap()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterInfluenceMap_Update);
+
+	const float PresenceDecay = FMath::Pow(0.5f, InfluenceUpdateInterval / FMath::Max(InfluencePresenceHalfLife, KINDA_SMALL_NUMBER));
+	const float DeathDecay = FMath::Pow(0.5f, InfluenceUpdateInterval / FMath::Max(InfluenceDeathHalfLife, KINDA_SMALL_NUMBER));
+
+	DecayLayers(0, NumTeamLayers, PresenceDecay);
+	DecayLayers(GetDeathLayer(), 1, DeathDecay);
+
+	// a character standing still converges to 1 in its cell
+	const float PresenceGain = 1.0f - PresenceDecay;
+
+	UShooterPawnRegistry* PawnRegistry = GetWorld()->GetSubsystem<UShooterPawnRegistry>();
+	const int32 NumCharacters = PawnRegistry ? PawnRegistry->Num() : 0;
+	for (int32 i = 0; i < NumCharacters; i++)
+	{
+		if (PawnRegistry->IsAlive(i))
+		{
+			Splat(GetTeamLayer(PawnRegistry->GetTeamNum(i)), PawnRegistry->GetLocation(i), PresenceGain);
+		}
+	}
+}
+
+void UShooterInfluenceMap::AddDeath(const FVector& Location)
+{
+	ConditionalInitialize();
+	Splat(GetDeathLayer(), Location, 1.0f);
+}
+
+float UShooterInfluenceMap::GetThreat(const FVector& Location, int32 TeamNum, const AActor* Querier)
+{
+	ConditionalInitialize();
+
+	const int32 CellIdx = GetCellIndex(Location);
+	if (NumTeamLayers == 1)
+	{
+		// free for all, everybody else is a threat
+		return FMath::Max(Layers[CellIdx] - GetSelfPresence(Location, Querier), 0.0f);
+	}
+
+	const int32 MyLayer = GetTeamLayer(TeamNum);
+	float Threat = 0.0f;
+	for (int32 Layer = 0; Layer < NumTeamLayers; Layer++)
+	{
+		if (Layer != MyLayer)
+		{
+			Threat += Layers[GetLayerOffset(Layer) + CellIdx];
+		}
+	}
+
+	return Threat;
+}
+
+float UShooterInfluenceMap::GetFriendlyPresence(const FVector& Location, int32 TeamNum, const AActor* Querier)
+{
+	ConditionalInitialize();
+
+	if (NumTeamLayers == 1)
+	{
+		return 0.0f;
+	}
+
+	return FMath::Max(Layers[GetLayerOffset(GetTeamLayer(TeamNum)) + GetCellIndex(Location)] - GetSelfPresence(Location, Querier), 0.0f);
+}
+
+float UShooterInfluenceMap::GetDeathHeat(const FVector& Location)
+{
+	ConditionalInitialize();
+
+	return Layers[GetLayerOffset(GetDeathLayer()) + GetCellIndex(Location)];
+}
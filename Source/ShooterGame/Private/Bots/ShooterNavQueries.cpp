@@ -0,0 +1,202 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterNavQueries.h"
+#include "NavigationSystem.h"
+
+static int32 BotNavPointQueriesPerFrame = 4;
+FAutoConsoleVariableRef CVarBotNavPointQueriesPerFrame(
+	TEXT("p.BotNavPointQueriesPerFrame"),
+	BotNavPointQueriesPerFrame,
+	TEXT("Max number of bot reachable point queries run per frame"),
+	ECVF_Default);
+
+static int32 BotNavPathQueriesPerFrame = 8;
+FAutoConsoleVariableRef CVarBotNavPathQueriesPerFrame(
+	TEXT("p.BotNavPathQueriesPerFrame"),
+	BotNavPathQueriesPerFrame,
+	TEXT("Max number of bot async path queries issued per frame"),
+	ECVF_Default);
+
+void UShooterNavQueries::Deinitialize()
+{
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearAllTimersForObject(this);
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (NavSys)
+	{
+		for (const TPair<uint32, FPathRequest>& Pending : PendingPaths)
+		{
+			NavSys->AbortAsyncFindPathRequest(Pending.Key);
+		}
+	}
+
+	PointQueue.Reset();
+	PathQueue.Reset();
+	PendingPaths.Reset();
+	bFlushScheduled = false;
+
+	Super::Deinitialize();
+}
+
+uint32 UShooterNavQueries::RequestReachablePoint(AController* Querier, const FVector& Origin, float Radius, const FShooterNavPointQueryDelegate& OnComplete)
+{
+	if (Querier == NULL)
+	{
+		return 0;
+	}
+
+	FPointRequest& Request = PointQueue.AddDefaulted_GetRef();
+	Request.RequestId = NextRequestId++;
+	Request.Querier = Querier;
+	Request.Origin = Origin;
+	Request.Radius = Radius;
+	Request.OnComplete = OnComplete;
+
+	ScheduleFlush();
+	return Request.RequestId;
+}
+
+uint32 UShooterNavQueries::RequestPath(AController* Querier, const FVector& Start, const FVector& End, const FShooterNavPathQueryDelegate& OnComplete)
+{
+	if (Querier == NULL)
+	{
+		return 0;
+	}
+
+	FPathRequest& Request = PathQueue.AddDefaulted_GetRef();
+	Request.RequestId = NextRequestId++;
+	Request.Querier = Querier;
+	Request.Start = Start;
+	Request.End = End;
+	Request.OnComplete = OnComplete;
+
+	ScheduleFlush();
+	return Request.RequestId;
+}
+
+void UShooterNavQueries::CancelRequest(uint32 RequestId)
+{
+	if (RequestId == 0)
+	{
+		return;
+	}
+
+	if (PointQueue.RemoveAll([RequestId](const FPointRequest& Request) { return Request.RequestId == RequestId; }) > 0)
+	{
+		return;
+	}
+
+	if (PathQueue.RemoveAll([RequestId](const FPathRequest& Request) { return Request.RequestId == RequestId; }) > 0)
+	{
+		return;
+	}
+
+	for (auto It = PendingPaths.CreateIterator(); It; ++It)
+	{
+		if (It.Value().RequestId == RequestId)
+		{
+			UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+			if (NavSys)
+			{
+				NavSys->AbortAsyncFindPathRequest(It.Key());
+			}
+			It.RemoveCurrent();
+			break;
+		}
+	}
+}
+
+void UShooterNavQueries::ScheduleFlush()
+{
+	if (!bFlushScheduled)
+	{
+		bFlushScheduled = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UShooterNavQueries::FlushRequests);
+	}
+}
+
+void UShooterNavQueries::FlushRequests()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterNavQueries_Flush);
+
+	bFlushScheduled = false;
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (NavSys == NULL)
+	{
+		// no navigation, fail everything
+		TArray<FPointRequest> FailedPoints = MoveTemp(PointQueue);
+		TArray<FPathRequest> FailedPaths = MoveTemp(PathQueue);
+		for (const FPointRequest& Request : FailedPoints)
+		{
+			Request.OnComplete.ExecuteIfBound(Request.RequestId, false, FVector::ZeroVector);
+		}
+		for (const FPathRequest& Request : FailedPaths)
+		{
+			Request.OnComplete.ExecuteIfBound(Request.RequestId, false, 0.0f);
+		}
+		return;
+	}
+
+	// path queries: hand over to async pathfinding
+	// requests are moved out first, delegates are free to queue new ones
+	const int32 NumPaths = FMath::Min(PathQueue.Num(), FMath::Max(BotNavPathQueriesPerFrame, 1));
+	TArray<FPathRequest> Paths;
+	Paths.Append(PathQueue.GetData(), NumPaths);
+	PathQueue.RemoveAt(0, NumPaths, false);
+
+	for (FPathRequest& Request : Paths)
+	{
+		AController* Querier = Request.Querier.Get();
+		const ANavigationData* NavData = Querier ? NavSys->GetNavDataForProps(Querier->GetNavAgentPropertiesRef()) : NULL;
+		if (NavData == NULL)
+		{
+			Request.OnComplete.ExecuteIfBound(Request.RequestId, false, 0.0f);
+			continue;
+		}
+
+		FPathFindingQuery Query(Querier, *NavData, Request.Start, Request.End);
+		const uint32 NavQueryId = NavSys->FindPathAsync(Querier->GetNavAgentPropertiesRef(), Query,
+			FNavPathQueryDelegate::CreateUObject(this, &UShooterNavQueries::OnPathFound), EPathFindingMode::Regular);
+		PendingPaths.Add(NavQueryId, MoveTemp(Request));
+	}
+
+	// reachable point queries: run here, the navigation system has no async version
+	const int32 NumPoints = FMath::Min(PointQueue.Num(), FMath::Max(BotNavPointQueriesPerFrame, 1));
+	TArray<FPointRequest> Points;
+	Points.Append(PointQueue.GetData(), NumPoints);
+	PointQueue.RemoveAt(0, NumPoints, false);
+
+	for (const FPointRequest& Request : Points)
+	{
+		AController* Querier = Request.Querier.Get();
+		ANavigationData* NavData = Querier ? NavSys->GetNavDataForProps(Querier->GetNavAgentPropertiesRef()) : NULL;
+
+		FNavLocation Point;
+		const bool bSuccess = NavData && NavSys->GetRandomReachablePointInRadius(Request.Origin, Request.Radius, Point, NavData);
+		Request.OnComplete.ExecuteIfBound(Request.RequestId, bSuccess, bSuccess ? Point.Location : FVector::ZeroVector);
+	}
+
+	if (PointQueue.Num() > 0 || PathQueue.Num() > 0)
+	{
+		ScheduleFlush();
+	}
+}
+
+void UShooterNavQueries::OnPathFound(uint32 NavQueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	FPathRequest Request;
+	if (!PendingPaths.RemoveAndCopyValue(NavQueryId, Request))
+	{
+		return;
+	}
+
+	const bool bPathExists = (Result == ENavigationQueryResult::Success) && Path.IsValid() && !Path->IsPartial();
+	const float PathLength = bPathExists ? static_cast<float>(Path->GetLength()) : 0.0f;
+	Request.OnComplete.ExecuteIfBound(Request.RequestId, bPathExists, PathLength);
+}
@@ -10,6 +10,11 @@
 #include "Online/ShooterGameSession.h"
 #include "Bots/ShooterAIController.h"
 #include "ShooterTeamStart.h"
+#include "Player/ShooterPawnRegistry.h"
+#include "Bots/ShooterInfluenceMap.h"
+#include "Online/ShooterLoadTest.h"
+#include "Bots/ShooterCrowdManager.h"
+#include "Online/ShooterMatchLog.h"
 
 
 AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -31,6 +36,8 @@ AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer)
 
 	bAllowBots = true;	
 	bNeedsBotCreation = true;
+	NumCrowdBots = 0;
+	bResetMatchInPlace = false;
 	bUseSeamlessTravel = FParse::Param(FCommandLine::Get(), TEXT("NoSeamlessTravel")) ? false : true;
 }
 
@@ -54,6 +61,16 @@ void AShooterGameMode::InitGame(const FString& MapName, const FString& Options,
 	SetAllowBots(BotsCountOptionValue > 0 ? true : false, BotsCountOptionValue);	
 	Super::InitGame(MapName, Options, ErrorMessage);
 
+	NumCrowdBots = UGameplayStatics::GetIntOption(Options, TEXT("CrowdBots"), 0);
+
+	// bot only load test: fill the match and make sure it outlasts the test
+	const UShooterLoadTest* LoadTest = GetWorld()->GetSubsystem<UShooterLoadTest>();
+	if (LoadTest)
+	{
+		SetAllowBots(true, LoadTest->GetNumBots());
+		RoundTime = FMath::Max(RoundTime, FMath::CeilToInt(LoadTest->GetDuration()) + 10);
+	}
+
 	const UGameInstance* GameInstance = GetGameInstance();
 	if (GameInstance && Cast<UShooterGameInstance>(GameInstance)->GetOnlineMode() != EOnlineMode::Offline)
 	{
@@ -168,6 +185,24 @@ void AShooterGameMode::HandleMatchHasStarted()
 	MyGameState->RemainingTime = RoundTime;	
 	StartBots();	
 
+	UShooterCrowdManager* CrowdManager = GetWorld()->GetSubsystem<UShooterCrowdManager>();
+	if (CrowdManager)
+	{
+		CrowdManager->SpawnCrowd(NumCrowdBots);
+	}
+
+	UShooterLoadTest* LoadTest = GetWorld()->GetSubsystem<UShooterLoadTest>();
+	if (LoadTest)
+	{
+		LoadTest->StartRecording();
+	}
+
+	UShooterMatchLog* MatchLog = GetWorld()->GetSubsystem<UShooterMatchLog>();
+	if (MatchLog)
+	{
+		MatchLog->BeginMatch();
+	}
+
 	// notify players
 	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
 	{
@@ -190,8 +225,26 @@ void AShooterGameMode::FinishMatch()
 	if (IsMatchInProgress())
 	{
 		EndMatch();
+
+		// final scores decide the winner, don't leave any of them pending
+		for (APlayerState* PlayerState : MyGameState->PlayerArray)
+		{
+			AShooterPlayerState* ShooterPlayerState = Cast<AShooterPlayerState>(PlayerState);
+			if (ShooterPlayerState)
+			{
+				ShooterPlayerState->FlushStats();
+				ShooterPlayerState->ForceNetUpdate();
+			}
+		}
+
 		DetermineMatchWinner();		
 
+		UShooterMatchLog* MatchLog = GetWorld()->GetSubsystem<UShooterMatchLog>();
+		if (MatchLog)
+		{
+			MatchLog->EndMatch();
+		}
+
 		// notify players
 		for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
 		{
@@ -313,6 +366,18 @@ void AShooterGameMode::Killed(AController* Killer, AController* KilledPlayer, AP
 		VictimPlayerState->ScoreDeath(KillerPlayerState, DeathScore);
 		VictimPlayerState->BroadcastDeath(KillerPlayerState, DamageType, VictimPlayerState);
 	}
+
+	UShooterInfluenceMap* InfluenceMap = GetWorld()->GetSubsystem<UShooterInfluenceMap>();
+	if (InfluenceMap && KilledPawn)
+	{
+		InfluenceMap->AddDeath(KilledPawn->GetActorLocation());
+	}
+
+	UShooterMatchLog* MatchLog = UShooterMatchLog::Get(this);
+	if (MatchLog)
+	{
+		MatchLog->Record(EShooterMatchEvent::Kill, KillerPlayerState, VictimPlayerState, 0.0f, KilledPawn ? KilledPawn->GetActorLocation() : FVector::ZeroVector);
+	}
 }
 
 float AShooterGameMode::ModifyDamage(float Damage, AActor* DamagedActor, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) const
@@ -336,6 +401,12 @@ float AShooterGameMode::ModifyDamage(float Damage, AActor* DamagedActor, struct
 		{
 			ActualDamage *= DamageSelfScale;
 		}
+
+		UShooterMatchLog* MatchLog = UShooterMatchLog::Get(this);
+		if (MatchLog)
+		{
+			MatchLog->Record(EShooterMatchEvent::Damage, InstigatorPlayerState, DamagedPlayerState, ActualDamage, DamagedPawn->GetActorLocation());
+		}
 	}
 
 	return ActualDamage;
@@ -368,8 +439,21 @@ UClass* AShooterGameMode::GetDefaultPawnClassForController_Implementation(AContr
 
 void AShooterGameMode::RestartPlayer(AController* NewPlayer)
 {
+	// crowd bots are placed by the crowd manager
+	AShooterAIController* AIC = Cast<AShooterAIController>(NewPlayer);
+	if (AIC && AIC->IsCrowdBot())
+	{
+		return;
+	}
+
 	Super::RestartPlayer(NewPlayer);
 
+	UShooterMatchLog* MatchLog = UShooterMatchLog::Get(this);
+	if (MatchLog && NewPlayer->GetPawn())
+	{
+		MatchLog->Record(EShooterMatchEvent::Spawn, NewPlayer->PlayerState, NULL, 0.0f, NewPlayer->GetPawn()->GetActorLocation());
+	}
+
 	AShooterPlayerController* PC = Cast<AShooterPlayerController>(NewPlayer);
 	if (PC)
 	{
@@ -386,45 +470,45 @@ void AShooterGameMode::RestartPlayer(AController* NewPlayer)
 
 AActor* AShooterGameMode::ChoosePlayerStart_Implementation(AController* Player)
 {
-	TArray<APlayerStart*> PreferredSpawns;
-	TArray<APlayerStart*> FallbackSpawns;
-
-	APlayerStart* BestStart = NULL;
-	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	if (!SpawnIndex.IsBuilt())
 	{
-		APlayerStart* TestSpawn = *It;
-		if (TestSpawn->IsA<APlayerStartPIE>())
-		{
-			// Always prefer the first "Play from Here" PlayerStart, if we find one while in PIE mode
-			BestStart = TestSpawn;
-			break;
-		}
-		else
-		{
-			if (IsSpawnpointAllowed(TestSpawn, Player))
-			{
-				if (IsSpawnpointPreferred(TestSpawn, Player))
-				{
-					PreferredSpawns.Add(TestSpawn);
-				}
-				else
-				{
-					FallbackSpawns.Add(TestSpawn);
-				}
-			}
-		}
+		SpawnIndex.Build(GetWorld());
 	}
 
-	
+	APlayerStart* BestStart = SpawnIndex.GetPIEStart();
 	if (BestStart == NULL)
 	{
-		if (PreferredSpawns.Num() > 0)
+		// starts allowed for a team and player kind don't change during the match
+		AShooterPlayerState* PlayerState = Player ? Cast<AShooterPlayerState>(Player->PlayerState) : NULL;
+		const FIntPoint CandidatesKey(PlayerState ? PlayerState->GetTeamNum() : INDEX_NONE, Cast<AShooterAIController>(Player) ? 1 : 0);
+		const TArray<int32>& Candidates = SpawnIndex.GetCandidates(CandidatesKey, [&](APlayerStart* TestSpawn)
 		{
-			BestStart = PreferredSpawns[FMath::RandHelper(PreferredSpawns.Num())];
-		}
-		else if (FallbackSpawns.Num() > 0)
+			return IsSpawnpointAllowed(TestSpawn, Player);
+		});
+
+		// team mates are skipped by the per team hash, free for all leaves the IsEnemyFor filter to drop ourselves
+		UShooterPawnRegistry* PawnRegistry = GetWorld()->GetSubsystem<UShooterPawnRegistry>();
+		AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
+		const int32 ExcludeTeamNum = (MyGameState && MyGameState->NumTeams > 1 && PlayerState) ? PlayerState->GetTeamNum() : INDEX_NONE;
+
+		const float Now = GetWorld()->GetTimeSeconds();
+		const int32 BestIdx = SpawnIndex.ChooseBest(Candidates, [&](APlayerStart* TestSpawn)
+		{
+			return IsSpawnpointPreferred(TestSpawn, Player);
+		}, [&](const FVector& Location, float MaxDist)
 		{
-			BestStart = FallbackSpawns[FMath::RandHelper(FallbackSpawns.Num())];
+			const int32 EnemyIdx = PawnRegistry ? PawnRegistry->FindNearestHostile(Location, ExcludeTeamNum, MaxDist, [&](int32 Idx)
+			{
+				return PawnRegistry->GetCharacter(Idx)->IsEnemyFor(Player);
+			}) : INDEX_NONE;
+
+			return (EnemyIdx != INDEX_NONE) ? FVector::Dist(Location, PawnRegistry->GetLocation(EnemyIdx)) : MaxDist;
+		}, Now);
+
+		if (BestIdx != INDEX_NONE)
+		{
+			SpawnIndex.MarkUsed(BestIdx, Now);
+			BestStart = SpawnIndex.GetStart(BestIdx);
 		}
 	}
 
@@ -461,23 +545,28 @@ bool AShooterGameMode::IsSpawnpointPreferred(APlayerStart* SpawnPoint, AControll
 		MyPawn = Cast<ACharacter>(BotPawnClass->GetDefaultObject<ACharacter>());
 	}
 	
-	if (MyPawn)
+	UShooterPawnRegistry* PawnRegistry = GetWorld()->GetSubsystem<UShooterPawnRegistry>();
+	if (MyPawn && PawnRegistry)
 	{
 		const FVector SpawnLocation = SpawnPoint->GetActorLocation();
-		for (ACharacter* OtherPawn : TActorRange<ACharacter>(GetWorld()))
+		const float MyHalfHeight = MyPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		const float MyRadius = MyPawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
+
+		// only pawns close enough to overlap the start need a closer look
+		TArray<int32> NearbyIndices;
+		PawnRegistry->FindInRadius(SpawnLocation, MyRadius + PawnRegistry->GetMaxCapsuleRadius(), [&](int32 Idx)
 		{
-			if (OtherPawn != MyPawn)
-			{
-				const float CombinedHeight = (MyPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()) * 2.0f;
-				const float CombinedRadius = MyPawn->GetCapsuleComponent()->GetScaledCapsuleRadius() + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
-				const FVector OtherLocation = OtherPawn->GetActorLocation();
+			const float CombinedHeight = (MyHalfHeight + PawnRegistry->GetCapsuleHalfHeight(Idx)) * 2.0f;
+			const float CombinedRadius = MyRadius + PawnRegistry->GetCapsuleRadius(Idx);
+			const FVector& OtherLocation = PawnRegistry->GetLocation(Idx);
 
-				// check if player start overlaps this pawn
-				if (FMath::Abs(SpawnLocation.Z - OtherLocation.Z) < CombinedHeight && (SpawnLocation - OtherLocation).Size2D() < CombinedRadius)
-				{
-					return false;
-				}
-			}
+			// check if player start overlaps this pawn
+			return FMath::Abs(SpawnLocation.Z - OtherLocation.Z) < CombinedHeight && (SpawnLocation - OtherLocation).Size2D() < CombinedRadius;
+		}, NearbyIndices);
+
+		if (NearbyIndices.Num() > 0)
+		{
+			return false;
 		}
 	}
 	else
@@ -495,7 +584,7 @@ void AShooterGameMode::CreateBotControllers()
 	for (FConstControllerIterator It = World->GetControllerIterator(); It; ++It)
 	{		
 		AShooterAIController* AIC = Cast<AShooterAIController>(*It);
-		if (AIC)
+		if (AIC && !AIC->IsCrowdBot())
 		{
 			++ExistingBots;
 		}
@@ -523,6 +612,15 @@ AShooterAIController* AShooterGameMode::CreateBot(int32 BotNum)
 	return AIC;
 }
 
+void AShooterGameMode::InitBotPlayerState(AShooterAIController* AIC, int32 BotNum)
+{
+	if (AIC && AIC->PlayerState == NULL)
+	{
+		AIC->InitPlayerState();
+		InitBot(AIC, BotNum);
+	}
+}
+
 void AShooterGameMode::StartBots()
 {
 	// checking number of existing human player.
@@ -566,6 +664,54 @@ void AShooterGameMode::RestartGame()
 		}
 	}
 
+	if (bResetMatchInPlace && GetMatchState() == MatchState::WaitingPostMatch)
+	{
+		ResetMatch();
+		return;
+	}
+
 	Super::RestartGame();
 }
 
+void AShooterGameMode::ResetMatch()
+{
+	UWorld* World = GetWorld();
+
+	// crowd bots go back to data first, so their pawns are not treated as regular bots below
+	UShooterCrowdManager* CrowdManager = World->GetSubsystem<UShooterCrowdManager>();
+	if (CrowdManager)
+	{
+		CrowdManager->ResetCrowd();
+	}
+
+	// bot pawns keep their controller and PlayerState, so APawn::Reset would leave them alive
+	for (FConstControllerIterator It = World->GetControllerIterator(); It; ++It)
+	{
+		AShooterAIController* AIC = Cast<AShooterAIController>(*It);
+		APawn* BotPawn = AIC ? AIC->GetPawn() : NULL;
+		if (BotPawn)
+		{
+			AIC->UnPossess();
+			BotPawn->Destroy();
+		}
+	}
+
+	// players who left belong to the finished match
+	for (APlayerState* InactivePlayerState : InactivePlayerArray)
+	{
+		if (InactivePlayerState)
+		{
+			InactivePlayerState->Destroy();
+		}
+	}
+	InactivePlayerArray.Empty();
+
+	// starts used at the end of the last match shouldn't be penalized in the new one
+	SpawnIndex.ResetUseTimes();
+
+	// resets controllers, player pawns, PlayerStates, pickups and the game state, then InitGameState
+	ResetLevel();
+
+	SetMatchState(MatchState::WaitingToStart);
+}
+
@@ -11,10 +11,12 @@ AShooterGameState::AShooterGameState(const FObjectInitializer& ObjectInitializer
 	NumTeams = 0;
 	RemainingTime = 0;
 	bTimerPaused = false;
+	RankingVersion = 0;
 
 	UShooterGameInstance* GameInstance = GetWorld() != nullptr ? Cast<UShooterGameInstance>(GetWorld()->GetGameInstance()) : nullptr;
 
 	GameMatches.Initialize(this, GameInstance);
+	PickupManager.Initialize(this);
 }
 
 void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
@@ -25,38 +27,145 @@ void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 	DOREPLIFETIME( AShooterGameState, RemainingTime );
 	DOREPLIFETIME( AShooterGameState, bTimerPaused );
 	DOREPLIFETIME( AShooterGameState, TeamScores );
+	DOREPLIFETIME( AShooterGameState, PickupAvailability );
 }
 
 void AShooterGameState::GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const
 {
 	OutRankedMap.Empty();
 
-	//first, we need to go over all the PlayerStates, grab their score, and rank them
-	TMultiMap<int32, AShooterPlayerState*> SortedMap;
-	for(int32 i = 0; i < PlayerArray.Num(); ++i)
+	const TArray<TWeakObjectPtr<AShooterPlayerState>>& TeamPlayers = GetRankedPlayers(TeamIndex);
+	for (int32 Rank = 0; Rank < TeamPlayers.Num(); ++Rank)
 	{
-		int32 Score = 0;
-		AShooterPlayerState* CurPlayerState = Cast<AShooterPlayerState>(PlayerArray[i]);
-		if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
+		OutRankedMap.Add(Rank, TeamPlayers[Rank]);
+	}
+}
+
+const TArray<TWeakObjectPtr<AShooterPlayerState>>& AShooterGameState::GetRankedPlayers(int32 TeamIndex) const
+{
+	static const TArray<TWeakObjectPtr<AShooterPlayerState>> NoPlayers;
+	return RankedPlayers.IsValidIndex(TeamIndex) ? RankedPlayers[TeamIndex] : NoPlayers;
+}
+
+void AShooterGameState::AddPlayerState(APlayerState* PlayerState)
+{
+	Super::AddPlayerState(PlayerState);
+
+	UpdatePlayerRanking(Cast<AShooterPlayerState>(PlayerState));
+}
+
+void AShooterGameState::RemovePlayerState(APlayerState* PlayerState)
+{
+	if (RemoveFromRanking(Cast<AShooterPlayerState>(PlayerState)))
+	{
+		RankingVersion++;
+	}
+
+	Super::RemovePlayerState(PlayerState);
+}
+
+void AShooterGameState::UpdatePlayerRanking(AShooterPlayerState* PlayerState)
+{
+	// inactive PlayerStates of players that left are not in PlayerArray, keep them out of the ranking too
+	if (PlayerState == NULL || !PlayerArray.Contains(PlayerState))
+	{
+		return;
+	}
+
+	const int32 TeamIndex = PlayerState->GetTeamNum();
+	if (TeamIndex < 0)
+	{
+		if (RemoveFromRanking(PlayerState))
 		{
-			SortedMap.Add(FMath::TruncToInt(CurPlayerState->GetScore()), CurPlayerState);
+			RankingVersion++;
 		}
+		return;
 	}
 
-	//sort by the keys
-	SortedMap.KeySort(TGreater<int32>());
+	if (TeamIndex >= RankedPlayers.Num())
+	{
+		RankedPlayers.SetNum(TeamIndex + 1);
+	}
 
-	//now, add them back to the ranked map
-	OutRankedMap.Empty();
+	TArray<TWeakObjectPtr<AShooterPlayerState>>& TeamPlayers = RankedPlayers[TeamIndex];
+	int32 Rank = TeamPlayers.IndexOfByKey(PlayerState);
+	if (Rank == INDEX_NONE)
+	{
+		// new player or team change
+		RemoveFromRanking(PlayerState);
+		Rank = TeamPlayers.Add(PlayerState);
+	}
 
-	int32 Rank = 0;
-	for(TMultiMap<int32, AShooterPlayerState*>::TIterator It(SortedMap); It; ++It)
+	auto GetRankScore = [](const TWeakObjectPtr<AShooterPlayerState>& RankedPlayer)
+	{
+		return RankedPlayer.IsValid() ? FMath::TruncToInt(RankedPlayer->GetScore()) : MIN_int32;
+	};
+
+	// scores change by small steps, so the player only moves past a few neighbours
+	const int32 Score = GetRankScore(TeamPlayers[Rank]);
+	while (Rank > 0 && Score > GetRankScore(TeamPlayers[Rank - 1]))
+	{
+		TeamPlayers.Swap(Rank, Rank - 1);
+		Rank--;
+	}
+	while (Rank < TeamPlayers.Num() - 1 && Score < GetRankScore(TeamPlayers[Rank + 1]))
 	{
-		OutRankedMap.Add(Rank++, It.Value());
+		TeamPlayers.Swap(Rank, Rank + 1);
+		Rank++;
 	}
-	
+
+	RankingVersion++;
 }
 
+void AShooterGameState::AddTeamScore(int32 TeamIndex, int32 Points)
+{
+	if (TeamIndex < 0)
+	{
+		return;
+	}
+
+	if (TeamIndex >= TeamScores.Num())
+	{
+		TeamScores.AddZeroed(TeamIndex - TeamScores.Num() + 1);
+	}
+
+	TeamScores[TeamIndex] += Points;
+}
+
+bool AShooterGameState::RemoveFromRanking(AShooterPlayerState* PlayerState)
+{
+	bool bRemoved = false;
+	for (TArray<TWeakObjectPtr<AShooterPlayerState>>& TeamPlayers : RankedPlayers)
+	{
+		// keep order of the remaining players, and drop any that got destroyed
+		bRemoved |= TeamPlayers.RemoveAll([PlayerState](const TWeakObjectPtr<AShooterPlayerState>& RankedPlayer)
+		{
+			return !RankedPlayer.IsValid() || RankedPlayer.Get() == PlayerState;
+		}) > 0;
+	}
+
+	return bRemoved;
+}
+
+
+void AShooterGameState::Reset()
+{
+	Super::Reset();
+
+	for (int32& TeamScore : TeamScores)
+	{
+		TeamScore = 0;
+	}
+
+	RemainingTime = 0;
+	bTimerPaused = false;
+	ElapsedTime = 0;
+}
+
+void AShooterGameState::OnRep_PickupAvailability()
+{
+	PickupManager.ApplyAvailability();
+}
 
 void AShooterGameState::RequestFinishAndExitToMainMenu()
 {
@@ -30,6 +30,9 @@ void AShooterGame_TeamDeathMatch::InitGameState()
 	if (MyGameState)
 	{
 		MyGameState->NumTeams = NumTeams;
+
+		// every team takes part in winner checks, even before scoring
+		MyGameState->TeamScores.SetNumZeroed(NumTeams);
 	}
 }
 
@@ -40,42 +43,34 @@ bool AShooterGame_TeamDeathMatch::CanDealDamage(AShooterPlayerState* DamageInsti
 
 int32 AShooterGame_TeamDeathMatch::ChooseTeam(AShooterPlayerState* ForPlayerState) const
 {
-	TArray<int32> TeamBalance;
-	TeamBalance.AddZeroed(NumTeams);
+	AShooterGameState const* const MyGameState = Cast<AShooterGameState>(GameState);
 
-	// get current team balance
-	for (int32 i = 0; i < GameState->PlayerArray.Num(); i++)
+	// find least populated team, random when it's equal
+	int32 BestTeam = 0;
+	int32 BestTeamPlayers = MAX_int32;
+	int32 NumBestTeams = 0;
+	for (int32 i = 0; i < NumTeams; i++)
 	{
-		AShooterPlayerState const* const TestPlayerState = Cast<AShooterPlayerState>(GameState->PlayerArray[i]);
-		if (TestPlayerState && TestPlayerState != ForPlayerState && TeamBalance.IsValidIndex(TestPlayerState->GetTeamNum()))
+		// team counts are kept by the game state, ForPlayerState may already be counted in its current team
+		int32 TeamPlayers = MyGameState ? MyGameState->GetNumTeamPlayers(i) : 0;
+		if (ForPlayerState && ForPlayerState->GetTeamNum() == i && MyGameState && MyGameState->GetRankedPlayers(i).Contains(ForPlayerState))
 		{
-			TeamBalance[TestPlayerState->GetTeamNum()]++;
+			TeamPlayers--;
 		}
-	}
 
-	// find least populated one
-	int32 BestTeamScore = TeamBalance[0];
-	for (int32 i = 1; i < TeamBalance.Num(); i++)
-	{
-		if (BestTeamScore > TeamBalance[i])
+		if (TeamPlayers < BestTeamPlayers)
 		{
-			BestTeamScore = TeamBalance[i];
+			BestTeam = i;
+			BestTeamPlayers = TeamPlayers;
+			NumBestTeams = 1;
 		}
-	}
-
-	// there could be more than one...
-	TArray<int32> BestTeams;
-	for (int32 i = 0; i < TeamBalance.Num(); i++)
-	{
-		if (TeamBalance[i] == BestTeamScore)
+		else if (TeamPlayers == BestTeamPlayers && FMath::RandHelper(++NumBestTeams) == 0)
 		{
-			BestTeams.Add(i);
+			BestTeam = i;
 		}
 	}
 
-	// get random from best list
-	const int32 RandomBestTeam = BestTeams[FMath::RandHelper(BestTeams.Num())];
-	return RandomBestTeam;
+	return BestTeam;
 }
 
 void AShooterGame_TeamDeathMatch::DetermineMatchWinner()
@@ -85,9 +80,9 @@ void AShooterGame_TeamDeathMatch::DetermineMatchWinner()
 	int32 BestTeam = -1;
 	int32 NumBestTeams = 1;
 
-	for (int32 i = 0; i < MyGameState->TeamScores.Num(); i++)
+	for (int32 i = 0; i < NumTeams; i++)
 	{
-		const int32 TeamScore = MyGameState->TeamScores[i];
+		const int32 TeamScore = MyGameState->GetTeamScore(i);
 		if (BestScore < TeamScore)
 		{
 			BestScore = TeamScore;
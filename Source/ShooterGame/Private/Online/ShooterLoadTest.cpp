@@ -0,0 +1,155 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterLoadTest.h"
+#include "Player/ShooterPawnRegistry.h"
+
+bool UShooterLoadTest::ShouldCreateSubsystem(UObject* Outer) const
+{
+	int32 TestBots = 0;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("BotLoadTest="), TestBots) || TestBots <= 0)
+	{
+		return false;
+	}
+
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UShooterLoadTest::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FParse::Value(FCommandLine::Get(), TEXT("BotLoadTest="), NumBots);
+
+	Duration = 300.0f;
+	FParse::Value(FCommandLine::Get(), TEXT("BotLoadTestDuration="), Duration);
+	Duration = FMath::Max(Duration, 1.0f);
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("BotLoadTestCsv="), CsvFilename))
+	{
+		CsvFilename = FPaths::ProfilingDir() / FString::Printf(TEXT("BotLoadTest-%s.csv"), *FDateTime::Now().ToString());
+	}
+
+	if (!IsRunningDedicatedServer())
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Bot load test is meant for dedicated servers, results include rendering and audio."));
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Bot load test: %d bots, %.0f s, writing to %s"), NumBots, Duration, *CsvFilename);
+}
+
+void UShooterLoadTest::Deinitialize()
+{
+	StopRecording();
+
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_FinishTest);
+	}
+
+	Super::Deinitialize();
+}
+
+void UShooterLoadTest::StartRecording()
+{
+	if (bRecording || Samples.Num() > 0)
+	{
+		return;
+	}
+
+	bRecording = true;
+	RecordingStartTime = FPlatformTime::Seconds();
+	LastFrameEndTime = RecordingStartTime;
+	WorldTickStartTime = 0.0;
+	PostActorTickTime = 0.0;
+
+	// one sample per frame at 30Hz for the whole test
+	Samples.Reserve(FMath::CeilToInt(Duration * 30.0f));
+
+	OnWorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UShooterLoadTest::OnWorldTickStart);
+	OnWorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UShooterLoadTest::OnWorldPostActorTick);
+	OnEndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UShooterLoadTest::OnEndFrame);
+
+	GetWorld()->GetTimerManager().SetTimer(TimerHandle_FinishTest, this, &UShooterLoadTest::FinishTest, Duration, false);
+}
+
+void UShooterLoadTest::StopRecording()
+{
+	if (bRecording)
+	{
+		FWorldDelegates::OnWorldTickStart.Remove(OnWorldTickStartHandle);
+		FWorldDelegates::OnWorldPostActorTick.Remove(OnWorldPostActorTickHandle);
+		FCoreDelegates::OnEndFrame.Remove(OnEndFrameHandle);
+		bRecording = false;
+	}
+}
+
+void UShooterLoadTest::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
+	{
+		WorldTickStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void UShooterLoadTest::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
+	{
+		PostActorTickTime = FPlatformTime::Seconds();
+	}
+}
+
+void UShooterLoadTest::OnEndFrame()
+{
+	const double Now = FPlatformTime::Seconds();
+	if (WorldTickStartTime > 0.0 && PostActorTickTime >= WorldTickStartTime)
+	{
+		UShooterPawnRegistry* PawnRegistry = GetWorld()->GetSubsystem<UShooterPawnRegistry>();
+
+		FFrameSample& Sample = Samples.AddDefaulted_GetRef();
+		Sample.Time = static_cast<float>(Now - RecordingStartTime);
+		Sample.FrameMs = static_cast<float>((Now - LastFrameEndTime) * 1000.0);
+		Sample.GameThreadMs = static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime));
+		Sample.WorldTickMs = static_cast<float>((PostActorTickTime - WorldTickStartTime) * 1000.0);
+		Sample.PostTickMs = static_cast<float>((Now - PostActorTickTime) * 1000.0);
+		Sample.UsedMemoryMB = static_cast<float>(FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0));
+		Sample.NumCharacters = 0;
+
+		// the registry keeps corpses too
+		const int32 NumRegistered = PawnRegistry ? PawnRegistry->Num() : 0;
+		for (int32 i = 0; i < NumRegistered; i++)
+		{
+			Sample.NumCharacters += PawnRegistry->IsAlive(i) ? 1 : 0;
+		}
+	}
+
+	LastFrameEndTime = Now;
+	WorldTickStartTime = 0.0;
+}
+
+void UShooterLoadTest::FinishTest()
+{
+	StopRecording();
+
+	FString Csv = TEXT("Time,FrameMs,GameThreadMs,WorldTickMs,PostTickMs,UsedMemoryMB,NumCharacters\n");
+	Csv.Reserve(Csv.Len() + Samples.Num() * 64);
+	for (const FFrameSample& Sample : Samples)
+	{
+		Csv += FString::Printf(TEXT("%.3f,%.3f,%.3f,%.3f,%.3f,%.1f,%d\n"),
+			Sample.Time, Sample.FrameMs, Sample.GameThreadMs, Sample.WorldTickMs, Sample.PostTickMs, Sample.UsedMemoryMB, Sample.NumCharacters);
+	}
+
+	if (FFileHelper::SaveStringToFile(Csv, *CsvFilename))
+	{
+		UE_LOG(LogShooter, Log, TEXT("Bot load test finished, %d frames written to %s"), Samples.Num(), *CsvFilename);
+	}
+	else
+	{
+		UE_LOG(LogShooter, Error, TEXT("Bot load test finished, failed to write %s"), *CsvFilename);
+	}
+
+	FPlatformMisc::RequestExit(false);
+}
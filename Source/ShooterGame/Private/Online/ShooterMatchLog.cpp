@@ -0,0 +1,148 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterMatchLog.h"
+#include "Async/Async.h"
+
+static int32 MatchLogEnabled = 1;
+FAutoConsoleVariableRef CVarMatchLogEnabled(
+	TEXT("p.MatchLogEnabled"),
+	MatchLogEnabled,
+	TEXT("Record combat events of server matches to Saved/MatchLogs, read when a match starts"),
+	ECVF_Default);
+
+static int32 MatchLogBufferSize = 16384;
+FAutoConsoleVariableRef CVarMatchLogBufferSize(
+	TEXT("p.MatchLogBufferSize"),
+	MatchLogBufferSize,
+	TEXT("Number of match log events buffered before they are written out"),
+	ECVF_Default);
+
+static_assert(sizeof(FShooterMatchEventRecord) == 32, "Match log records are written as is, keep the layout fixed");
+
+bool UShooterMatchLog::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UShooterMatchLog::Deinitialize()
+{
+	EndMatch();
+
+	if (PendingWrite.IsValid())
+	{
+		PendingWrite.Wait();
+	}
+
+	Super::Deinitialize();
+}
+
+UShooterMatchLog* UShooterMatchLog::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : NULL;
+	UShooterMatchLog* MatchLog = World ? World->GetSubsystem<UShooterMatchLog>() : NULL;
+	return (MatchLog && MatchLog->bRecording) ? MatchLog : NULL;
+}
+
+void UShooterMatchLog::BeginMatch()
+{
+	if (bRecording)
+	{
+		EndMatch();
+	}
+
+	if (!MatchLogEnabled || GetWorld()->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	Filename = FPaths::ProjectSavedDir() / TEXT("MatchLogs") / FString::Printf(TEXT("%s-%s.smlog"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString());
+	Buffer.Reset(FMath::Max(MatchLogBufferSize, 64));
+	bNeedsHeader = true;
+	bRecording = true;
+
+	Record(EShooterMatchEvent::MatchStart, NULL, NULL, 0.0f, FVector::ZeroVector);
+}
+
+void UShooterMatchLog::EndMatch()
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	Record(EShooterMatchEvent::MatchEnd, NULL, NULL, 0.0f, FVector::ZeroVector);
+	Flush();
+
+	bRecording = false;
+	UE_LOG(LogShooter, Log, TEXT("Match log written to %s"), *Filename);
+}
+
+void UShooterMatchLog::Record(EShooterMatchEvent::Type Type, const APlayerState* Instigator, const APlayerState* Target, float Value, const FVector& Location)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	Buffer.AddUninitialized();
+	FShooterMatchEventRecord& Event = Buffer.Last();
+	Event.Time = GetWorld()->GetTimeSeconds();
+	Event.Type = (uint8)Type;
+	Event.Padding[0] = Event.Padding[1] = Event.Padding[2] = 0;
+	Event.InstigatorId = Instigator ? Instigator->GetPlayerId() : INDEX_NONE;
+	Event.TargetId = Target ? Target->GetPlayerId() : INDEX_NONE;
+	Event.Value = Value;
+	Event.X = Location.X;
+	Event.Y = Location.Y;
+	Event.Z = Location.Z;
+
+	if (Buffer.Num() >= MatchLogBufferSize)
+	{
+		Flush();
+	}
+}
+
+void UShooterMatchLog::Flush()
+{
+	if (Buffer.Num() == 0)
+	{
+		return;
+	}
+
+	// swap in a fresh buffer, the game thread never waits for the disk
+	TArray<FShooterMatchEventRecord> Block = MoveTemp(Buffer);
+	Buffer.Reset(FMath::Max(MatchLogBufferSize, 64));
+
+	const bool bWriteHeader = bNeedsHeader;
+	bNeedsHeader = false;
+
+	PendingWrite = Async(EAsyncExecution::ThreadPool, [PreviousWrite = MoveTemp(PendingWrite), Block = MoveTemp(Block), File = Filename, bWriteHeader]() mutable
+	{
+		if (PreviousWrite.IsValid())
+		{
+			PreviousWrite.Wait();
+		}
+
+		IFileManager& FileManager = IFileManager::Get();
+		TUniquePtr<FArchive> Writer(FileManager.CreateFileWriter(*File, bWriteHeader ? 0 : FILEWRITE_Append));
+		if (!Writer)
+		{
+			UE_LOG(LogShooter, Warning, TEXT("Failed to write match log %s"), *File);
+			return;
+		}
+
+		if (bWriteHeader)
+		{
+			FShooterMatchLogHeader Header;
+			Header.Magic = FShooterMatchLogHeader::ExpectedMagic;
+			Header.Version = FShooterMatchLogHeader::CurrentVersion;
+			Header.RecordSize = sizeof(FShooterMatchEventRecord);
+			Header.Reserved = 0;
+			Writer->Serialize(&Header, sizeof(Header));
+		}
+
+		Writer->Serialize(Block.GetData(), Block.Num() * sizeof(FShooterMatchEventRecord));
+	});
+}
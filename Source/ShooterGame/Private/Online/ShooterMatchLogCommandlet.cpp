@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterMatchLogCommandlet.h"
+#include "Online/ShooterMatchLog.h"
+
+UShooterMatchLogCommandlet::UShooterMatchLogCommandlet(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+static const TCHAR* GetMatchEventName(uint8 Type)
+{
+	switch (Type)
+	{
+		case EShooterMatchEvent::MatchStart:	return TEXT("MatchStart");
+		case EShooterMatchEvent::MatchEnd:		return TEXT("MatchEnd");
+		case EShooterMatchEvent::Spawn:			return TEXT("Spawn");
+		case EShooterMatchEvent::Kill:			return TEXT("Kill");
+		case EShooterMatchEvent::Damage:		return TEXT("Damage");
+		case EShooterMatchEvent::BulletsFired:	return TEXT("BulletsFired");
+		case EShooterMatchEvent::RocketsFired:	return TEXT("RocketsFired");
+		case EShooterMatchEvent::Pickup:		return TEXT("Pickup");
+		default:								return TEXT("Unknown");
+	}
+}
+
+/** write one field of every record as a flat array */
+template<typename T, typename GetterType>
+static bool WriteMatchLogColumn(const FString& Filename, const TArray<FShooterMatchEventRecord>& Records, GetterType Getter)
+{
+	TArray<T> Column;
+	Column.Reserve(Records.Num());
+	for (const FShooterMatchEventRecord& Record : Records)
+	{
+		Column.Add(Getter(Record));
+	}
+
+	return FFileHelper::SaveArrayToFile(TArrayView<const uint8>((const uint8*)Column.GetData(), Column.Num() * sizeof(T)), *Filename);
+}
+
+int32 UShooterMatchLogCommandlet::Main(const FString& Params)
+{
+	FString InFilename;
+	if (!FParse::Value(*Params, TEXT("In="), InFilename))
+	{
+		UE_LOG(LogShooter, Error, TEXT("Usage: -run=ShooterMatchLog -In=<file.smlog> [-Out=<file.csv>] [-Columns]"));
+		return 1;
+	}
+
+	FString OutFilename;
+	if (!FParse::Value(*Params, TEXT("Out="), OutFilename))
+	{
+		OutFilename = FPaths::ChangeExtension(InFilename, TEXT("csv"));
+	}
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *InFilename))
+	{
+		UE_LOG(LogShooter, Error, TEXT("Can't read %s"), *InFilename);
+		return 1;
+	}
+
+	FShooterMatchLogHeader Header;
+	if (Data.Num() < (int32)sizeof(Header))
+	{
+		UE_LOG(LogShooter, Error, TEXT("%s is not a match log"), *InFilename);
+		return 1;
+	}
+
+	FMemory::Memcpy(&Header, Data.GetData(), sizeof(Header));
+	if (Header.Magic != FShooterMatchLogHeader::ExpectedMagic || Header.Version != FShooterMatchLogHeader::CurrentVersion || Header.RecordSize != sizeof(FShooterMatchEventRecord))
+	{
+		UE_LOG(LogShooter, Error, TEXT("%s is not a match log of this version"), *InFilename);
+		return 1;
+	}
+
+	// a truncated last record means the server went down while writing, keep the complete ones
+	const int32 NumRecords = (Data.Num() - sizeof(Header)) / sizeof(FShooterMatchEventRecord);
+	TArray<FShooterMatchEventRecord> Records;
+	Records.SetNumUninitialized(NumRecords);
+	FMemory::Memcpy(Records.GetData(), Data.GetData() + sizeof(Header), NumRecords * sizeof(FShooterMatchEventRecord));
+
+	if (FParse::Param(*Params, TEXT("Columns")))
+	{
+		const FString Base = FPaths::GetPath(OutFilename) / FPaths::GetBaseFilename(OutFilename);
+		const bool bWritten =
+			WriteMatchLogColumn<float>(Base + TEXT(".time.f32"), Records, [](const FShooterMatchEventRecord& R) { return R.Time; })
+			&& WriteMatchLogColumn<uint8>(Base + TEXT(".type.u8"), Records, [](const FShooterMatchEventRecord& R) { return R.Type; })
+			&& WriteMatchLogColumn<int32>(Base + TEXT(".instigator.i32"), Records, [](const FShooterMatchEventRecord& R) { return R.InstigatorId; })
+			&& WriteMatchLogColumn<int32>(Base + TEXT(".target.i32"), Records, [](const FShooterMatchEventRecord& R) { return R.TargetId; })
+			&& WriteMatchLogColumn<float>(Base + TEXT(".value.f32"), Records, [](const FShooterMatchEventRecord& R) { return R.Value; })
+			&& WriteMatchLogColumn<float>(Base + TEXT(".x.f32"), Records, [](const FShooterMatchEventRecord& R) { return R.X; })
+			&& WriteMatchLogColumn<float>(Base + TEXT(".y.f32"), Records, [](const FShooterMatchEventRecord& R) { return R.Y; })
+			&& WriteMatchLogColumn<float>(Base + TEXT(".z.f32"), Records, [](const FShooterMatchEventRecord& R) { return R.Z; });
+
+		if (!bWritten)
+		{
+			UE_LOG(LogShooter, Error, TEXT("Failed to write columns to %s.*"), *Base);
+			return 1;
+		}
+
+		UE_LOG(LogShooter, Display, TEXT("%d events written to %s.*"), NumRecords, *Base);
+		return 0;
+	}
+
+	FString Csv = TEXT("Time,Event,InstigatorId,TargetId,Value,X,Y,Z") LINE_TERMINATOR;
+	for (const FShooterMatchEventRecord& Record : Records)
+	{
+		Csv += FString::Printf(TEXT("%.3f,%s,%d,%d,%.2f,%.0f,%.0f,%.0f") LINE_TERMINATOR,
+			Record.Time, GetMatchEventName(Record.Type), Record.InstigatorId, Record.TargetId, Record.Value, Record.X, Record.Y, Record.Z);
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutFilename))
+	{
+		UE_LOG(LogShooter, Error, TEXT("Failed to write %s"), *OutFilename);
+		return 1;
+	}
+
+	UE_LOG(LogShooter, Display, TEXT("%d events written to %s"), NumRecords, *OutFilename);
+	return 0;
+}
@@ -3,6 +3,14 @@
 #include "ShooterGame.h"
 #include "ShooterPlayerState.h"
 #include "Net/OnlineEngineInterface.h"
+#include "Online/ShooterMatchLog.h"
+
+static float PlayerStatsFlushInterval = 0.5f;
+FAutoConsoleVariableRef CVarPlayerStatsFlushInterval(
+	TEXT("p.PlayerStatsFlushInterval"),
+	PlayerStatsFlushInterval,
+	TEXT("Seconds kills, deaths and score are accumulated on the server before they are replicated, 0 flushes immediately"),
+	ECVF_Default);
 
 AShooterPlayerState::AShooterPlayerState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -11,6 +19,9 @@ AShooterPlayerState::AShooterPlayerState(const FObjectInitializer& ObjectInitial
 	NumDeaths = 0;
 	NumBulletsFired = 0;
 	NumRocketsFired = 0;
+	PendingKills = 0;
+	PendingDeaths = 0;
+	PendingScore = 0;
 	bQuitter = false;
 }
 
@@ -24,7 +35,13 @@ void AShooterPlayerState::Reset()
 	NumDeaths = 0;
 	NumBulletsFired = 0;
 	NumRocketsFired = 0;
+	PendingKills = 0;
+	PendingDeaths = 0;
+	PendingScore = 0;
 	bQuitter = false;
+
+	GetWorldTimerManager().ClearTimer(TimerHandle_FlushStats);
+	UpdateRanking();
 }
 
 void AShooterPlayerState::RegisterPlayerWithSession(bool bWasFromInvite)
@@ -43,6 +60,21 @@ void AShooterPlayerState::UnregisterPlayerWithSession()
 	}
 }
 
+void AShooterPlayerState::OnRep_Score()
+{
+	Super::OnRep_Score();
+
+	UpdateRanking();
+}
+
+void AShooterPlayerState::Destroyed()
+{
+	// still in the game state here, team score and ranking get the final values
+	FlushStats();
+
+	Super::Destroyed();
+}
+
 void AShooterPlayerState::ClientInitialize(AController* InController)
 {
 	Super::ClientInitialize(InController);
@@ -55,21 +87,51 @@ void AShooterPlayerState::SetTeamNum(int32 NewTeamNumber)
 	TeamNumber = NewTeamNumber;
 
 	UpdateTeamColors();
+	UpdateRanking();
 }
 
 void AShooterPlayerState::OnRep_TeamColor()
 {
 	UpdateTeamColors();
+	UpdateRanking();
 }
 
 void AShooterPlayerState::AddBulletsFired(int32 NumBullets)
 {
+	if (!HasAuthority())
+	{
+		return;
+	}
+
 	NumBulletsFired += NumBullets;
+
+	UShooterMatchLog* MatchLog = UShooterMatchLog::Get(this);
+	if (MatchLog)
+	{
+		MatchLog->Record(EShooterMatchEvent::BulletsFired, this, NULL, NumBullets, GetPawn() ? GetPawn()->GetActorLocation() : FVector::ZeroVector);
+	}
 }
 
 void AShooterPlayerState::AddRocketsFired(int32 NumRockets)
 {
+	if (!HasAuthority())
+	{
+		return;
+	}
+
 	NumRocketsFired += NumRockets;
+
+	UShooterMatchLog* MatchLog = UShooterMatchLog::Get(this);
+	if (MatchLog)
+	{
+		MatchLog->Record(EShooterMatchEvent::RocketsFired, this, NULL, NumRockets, GetPawn() ? GetPawn()->GetActorLocation() : FVector::ZeroVector);
+	}
+}
+
+void AShooterPlayerState::SetShotStats(int32 InNumBulletsFired, int32 InNumRocketsFired)
+{
+	NumBulletsFired = InNumBulletsFired;
+	NumRocketsFired = InNumRocketsFired;
 }
 
 void AShooterPlayerState::SetQuitter(bool bInQuitter)
@@ -84,6 +146,9 @@ void AShooterPlayerState::SetMatchId(const FString& CurrentMatchId)
 
 void AShooterPlayerState::CopyProperties(APlayerState* PlayerState)
 {	
+	// inactive and travelling copies only take flushed values
+	FlushStats();
+
 	Super::CopyProperties(PlayerState);
 
 	AShooterPlayerState* ShooterPlayer = Cast<AShooterPlayerState>(PlayerState);
@@ -101,7 +166,7 @@ void AShooterPlayerState::UpdateTeamColors()
 		AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(OwnerController->GetCharacter());
 		if (ShooterCharacter != NULL)
 		{
-			ShooterCharacter->UpdateTeamColorsAllMIDs();
+			ShooterCharacter->UpdateTeamColors();
 		}
 	}
 }
@@ -113,12 +178,12 @@ int32 AShooterPlayerState::GetTeamNum() const
 
 int32 AShooterPlayerState::GetKills() const
 {
-	return NumKills;
+	return NumKills + PendingKills;
 }
 
 int32 AShooterPlayerState::GetDeaths() const
 {
-	return NumDeaths;
+	return NumDeaths + PendingDeaths;
 }
 
 int32 AShooterPlayerState::GetNumBulletsFired() const
@@ -143,30 +208,64 @@ FString AShooterPlayerState::GetMatchId() const
 
 void AShooterPlayerState::ScoreKill(AShooterPlayerState* Victim, int32 Points)
 {
-	NumKills++;
+	PendingKills++;
 	ScorePoints(Points);
 }
 
 void AShooterPlayerState::ScoreDeath(AShooterPlayerState* KilledBy, int32 Points)
 {
-	NumDeaths++;
+	PendingDeaths++;
 	ScorePoints(Points);
 }
 
 void AShooterPlayerState::ScorePoints(int32 Points)
 {
-	AShooterGameState* const MyGameState = GetWorld()->GetGameState<AShooterGameState>();
-	if (MyGameState && TeamNumber >= 0)
+	PendingScore += Points;
+
+	if (PlayerStatsFlushInterval <= 0.0f)
 	{
-		if (TeamNumber >= MyGameState->TeamScores.Num())
-		{
-			MyGameState->TeamScores.AddZeroed(TeamNumber - MyGameState->TeamScores.Num() + 1);
-		}
+		FlushStats();
+	}
+	else if (!GetWorldTimerManager().IsTimerActive(TimerHandle_FlushStats))
+	{
+		GetWorldTimerManager().SetTimer(TimerHandle_FlushStats, this, &AShooterPlayerState::FlushStats, PlayerStatsFlushInterval, false);
+	}
+}
+
+void AShooterPlayerState::FlushStats()
+{
+	GetWorldTimerManager().ClearTimer(TimerHandle_FlushStats);
 
-		MyGameState->TeamScores[TeamNumber] += Points;
+	if (PendingKills == 0 && PendingDeaths == 0 && PendingScore == 0)
+	{
+		return;
 	}
 
-	SetScore(GetScore() + Points);
+	NumKills += PendingKills;
+	NumDeaths += PendingDeaths;
+
+	AShooterGameState* const MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (MyGameState && PendingScore != 0)
+	{
+		MyGameState->AddTeamScore(TeamNumber, PendingScore);
+	}
+
+	SetScore(GetScore() + PendingScore);
+
+	PendingKills = 0;
+	PendingDeaths = 0;
+	PendingScore = 0;
+
+	UpdateRanking();
+}
+
+void AShooterPlayerState::UpdateRanking()
+{
+	AShooterGameState* const MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (MyGameState)
+	{
+		MyGameState->UpdatePlayerRanking(this);
+	}
 }
 
 void AShooterPlayerState::InformAboutKill_Implementation(class AShooterPlayerState* KillerPlayerState, const UDamageType* KillerDamageType, class AShooterPlayerState* KilledPlayerState)
@@ -156,6 +156,7 @@ void UShooterReplicationGraph::ResetGameWorldState()
 	Super::ResetGameWorldState();
 
 	AlwaysRelevantStreamingLevelActors.Empty();
+	CharacterInventoryLists.Empty();
 
 	for (UNetReplicationGraphConnection* ConnManager : Connections)
 	{
@@ -350,6 +351,8 @@ void UShooterReplicationGraph::InitGlobalActorClassSettings()
 	
 	AShooterCharacter::NotifyEquipWeapon.AddUObject(this, &UShooterReplicationGraph::OnCharacterEquipWeapon);
 	AShooterCharacter::NotifyUnEquipWeapon.AddUObject(this, &UShooterReplicationGraph::OnCharacterUnEquipWeapon);
+	AShooterCharacter::NotifyAddInventoryWeapon.AddUObject(this, &UShooterReplicationGraph::OnCharacterAddInventoryWeapon);
+	AShooterCharacter::NotifyRemoveInventoryWeapon.AddUObject(this, &UShooterReplicationGraph::OnCharacterRemoveInventoryWeapon);
 
 #if WITH_GAMEPLAY_DEBUGGER
 	AGameplayDebuggerCategoryReplicator::NotifyDebuggerOwnerChange.AddUObject(this, &UShooterReplicationGraph::OnGameplayDebuggerOwnerChange);
@@ -452,6 +455,19 @@ void UShooterReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedA
 
 void UShooterReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
 {
+	if (AShooterCharacter* Character = Cast<AShooterCharacter>(ActorInfo.Actor))
+	{
+		CharacterInventoryLists.Remove(Character);
+	}
+	else if (AShooterWeapon* Weapon = Cast<AShooterWeapon>(ActorInfo.Actor))
+	{
+		// Weapons destroyed without leaving the inventory first
+		for (TPair<AShooterCharacter*, FActorRepListRefView>& InventoryPair : CharacterInventoryLists)
+		{
+			InventoryPair.Value.RemoveFast(Weapon);
+		}
+	}
+
 	EClassRepNodeMapping Policy = GetMappingPolicy(ActorInfo.Class);
 	switch(Policy)
 	{
@@ -524,6 +540,30 @@ void UShooterReplicationGraph::OnCharacterUnEquipWeapon(AShooterCharacter* Chara
 	}
 }
 
+void UShooterReplicationGraph::OnCharacterAddInventoryWeapon(AShooterCharacter* Character, AShooterWeapon* Weapon)
+{
+	if (Character && Weapon)
+	{
+		CHECK_WORLDS(Character);
+
+		FActorRepListRefView& InventoryList = CharacterInventoryLists.FindOrAdd(Character);
+		InventoryList.ConditionalAdd(Weapon);
+	}
+}
+
+void UShooterReplicationGraph::OnCharacterRemoveInventoryWeapon(AShooterCharacter* Character, AShooterWeapon* Weapon)
+{
+	if (Character && Weapon)
+	{
+		CHECK_WORLDS(Character);
+
+		if (FActorRepListRefView* InventoryList = CharacterInventoryLists.Find(Character))
+		{
+			InventoryList->RemoveFast(Weapon);
+		}
+	}
+}
+
 #if WITH_GAMEPLAY_DEBUGGER
 void UShooterReplicationGraph::OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner)
 {
@@ -635,14 +675,11 @@ void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorLists
 					ReplicationActorList.ConditionalAdd(Pawn);
 				}
 
-				int32 InventoryCount = Pawn->GetInventoryCount();
-				for (int32 i = 0; i < InventoryCount; ++i)
+				// Inventory list is maintained by the inventory notifications, just hand it over
+				const FActorRepListRefView* InventoryList = ShooterGraph->CharacterInventoryLists.Find(Pawn);
+				if (InventoryList && InventoryList->Num() > 0)
 				{
-					AShooterWeapon* Weapon = Pawn->GetInventoryWeapon(i);
-					if (Weapon)
-					{
-						ReplicationActorList.ConditionalAdd(Weapon);
-					}
+					Params.OutGatheredReplicationLists.AddReplicationActorList(*InventoryList);
 				}
 			}
 
@@ -64,6 +64,11 @@ public:
 
 	void OnCharacterEquipWeapon(AShooterCharacter* Character, AShooterWeapon* NewWeapon);
 	void OnCharacterUnEquipWeapon(AShooterCharacter* Character, AShooterWeapon* OldWeapon);
+	void OnCharacterAddInventoryWeapon(AShooterCharacter* Character, AShooterWeapon* Weapon);
+	void OnCharacterRemoveInventoryWeapon(AShooterCharacter* Character, AShooterWeapon* Weapon);
+
+	/** Inventory weapons per character, kept up to date by inventory notifications instead of walking inventories every frame */
+	TMap<AShooterCharacter*, FActorRepListRefView> CharacterInventoryLists;
 
 #if WITH_GAMEPLAY_DEBUGGER
 	void OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner);
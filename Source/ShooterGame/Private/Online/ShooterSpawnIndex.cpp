@@ -0,0 +1,143 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterSpawnIndex.h"
+#include "GameFramework/PlayerStart.h"
+
+static float SpawnSafeDistance = 4000.0f;
+FAutoConsoleVariableRef CVarSpawnSafeDistance(
+	TEXT("p.SpawnSafeDistance"),
+	SpawnSafeDistance,
+	TEXT("Distance to closest enemy beyond which spawn points are considered equally safe"),
+	ECVF_Default);
+
+static float SpawnRecentUseTime = 5.0f;
+FAutoConsoleVariableRef CVarSpawnRecentUseTime(
+	TEXT("p.SpawnRecentUseTime"),
+	SpawnRecentUseTime,
+	TEXT("Time (s) a spawn point stays penalized after being used"),
+	ECVF_Default);
+
+/** score lost by a spawn point used right now, fades out over p.SpawnRecentUseTime */
+static const float SpawnRecentUsePenalty = 2000.0f;
+
+/** random score added to spread players over equally good spawn points */
+static const float SpawnScoreJitter = 250.0f;
+
+FShooterSpawnIndex::FShooterSpawnIndex()
+	: bBuilt(false)
+{
+}
+
+void FShooterSpawnIndex::Build(UWorld* World)
+{
+	Reset();
+
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		APlayerStart* Start = *It;
+		if (Start->IsA<APlayerStartPIE>())
+		{
+			// Always prefer the first "Play from Here" PlayerStart
+			if (!PIEStart.IsValid())
+			{
+				PIEStart = Start;
+			}
+			continue;
+		}
+
+		Starts.Add(Start);
+		Locations.Add(Start->GetActorLocation());
+		LastUseTimes.Add(-MAX_FLT);
+	}
+
+	bBuilt = true;
+}
+
+const TArray<int32>& FShooterSpawnIndex::GetCandidates(const FIntPoint& Key, TFunctionRef<bool(APlayerStart*)> IsAllowed)
+{
+	TArray<int32>* Candidates = CandidateLists.Find(Key);
+	if (Candidates == NULL)
+	{
+		Candidates = &CandidateLists.Add(Key);
+		for (int32 i = 0; i < Starts.Num(); i++)
+		{
+			APlayerStart* Start = Starts[i].Get();
+			if (Start && IsAllowed(Start))
+			{
+				Candidates->Add(i);
+			}
+		}
+	}
+
+	return *Candidates;
+}
+
+int32 FShooterSpawnIndex::ChooseBest(const TArray<int32>& Candidates, TFunctionRef<bool(APlayerStart*)> IsPreferred, TFunctionRef<float(const FVector&, float)> GetEnemyDist, float Now) const
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterSpawnIndex_ChooseBest);
+
+	const float RecentUseTime = FMath::Max(SpawnRecentUseTime, KINDA_SMALL_NUMBER);
+
+	int32 BestPreferred = INDEX_NONE;
+	int32 BestFallback = INDEX_NONE;
+	float BestPreferredScore = -MAX_FLT;
+	float BestFallbackScore = -MAX_FLT;
+
+	for (int32 StartIdx : Candidates)
+	{
+		APlayerStart* Start = Starts[StartIdx].Get();
+		if (Start == NULL)
+		{
+			continue;
+		}
+
+		// enemies beyond the safe distance don't change the score, so the lookup never has to go further
+		const float ClosestEnemyDist = FMath::Min(GetEnemyDist(Locations[StartIdx], SpawnSafeDistance), SpawnSafeDistance);
+
+		const float TimeSinceUse = Now - LastUseTimes[StartIdx];
+		const float UsePenalty = SpawnRecentUsePenalty * FMath::Max(0.0f, 1.0f - TimeSinceUse / RecentUseTime);
+		const float Score = ClosestEnemyDist - UsePenalty + FMath::FRand() * SpawnScoreJitter;
+
+		// pawn registry doesn't see pawns spawned this frame yet, so starts used this frame count as blocked
+		const bool bPreferred = TimeSinceUse > 0.0f && IsPreferred(Start);
+		if (bPreferred && Score > BestPreferredScore)
+		{
+			BestPreferred = StartIdx;
+			BestPreferredScore = Score;
+		}
+		else if (!bPreferred && Score > BestFallbackScore)
+		{
+			BestFallback = StartIdx;
+			BestFallbackScore = Score;
+		}
+	}
+
+	return (BestPreferred != INDEX_NONE) ? BestPreferred : BestFallback;
+}
+
+void FShooterSpawnIndex::MarkUsed(int32 Index, float Now)
+{
+	if (LastUseTimes.IsValidIndex(Index))
+	{
+		LastUseTimes[Index] = Now;
+	}
+}
+
+void FShooterSpawnIndex::ResetUseTimes()
+{
+	for (float& LastUseTime : LastUseTimes)
+	{
+		LastUseTime = -MAX_FLT;
+	}
+}
+
+void FShooterSpawnIndex::Reset()
+{
+	Starts.Reset();
+	Locations.Reset();
+	LastUseTimes.Reset();
+	CandidateLists.Reset();
+	PIEStart.Reset();
+	bBuilt = false;
+}
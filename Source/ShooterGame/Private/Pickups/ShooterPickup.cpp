@@ -3,6 +3,8 @@
 #include "ShooterGame.h"
 #include "Pickups/ShooterPickup.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "Player/ShooterPawnRegistry.h"
+#include "Online/ShooterMatchLog.h"
 
 AShooterPickup::AShooterPickup(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -25,19 +27,64 @@ AShooterPickup::AShooterPickup(const FObjectInitializer& ObjectInitializer) : Su
 
 	SetRemoteRoleForBackwardsCompat(ROLE_SimulatedProxy);
 	bReplicates = true;
+
+	// state comes from the game state bitfield, level pickups never need their own channel
+	NetDormancy = DORM_Initial;
 }
 
 void AShooterPickup::BeginPlay()
 {
 	Super::BeginPlay();
 
-	RespawnPickup();
-
-	// register on pickup list (server only), don't care about unregistering (in FinishDestroy) - no streaming
+	// register on pickup list (server only), the index forgets us in EndPlay
 	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
 	if (GameMode)
 	{
 		GameMode->LevelPickups.Add(this);
+		GameMode->GetPickupIndex().AddPickup(this);
+	}
+
+	AShooterGameState* MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (MyGameState)
+	{
+		MyGameState->GetPickupManager().RegisterPickup(this);
+	}
+
+	if (HasAuthority())
+	{
+		RespawnPickup();
+	}
+}
+
+void AShooterPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (GameMode)
+	{
+		GameMode->GetPickupIndex().RemovePickup(this);
+	}
+
+	AShooterGameState* MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (MyGameState)
+	{
+		MyGameState->GetPickupManager().UnregisterPickup(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AShooterPickup::Reset()
+{
+	Super::Reset();
+
+	if (!bIsActive)
+	{
+		AShooterGameState* MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+		if (MyGameState)
+		{
+			MyGameState->GetPickupManager().CancelRespawn(this);
+		}
+		RespawnPickup();
 	}
 }
 
@@ -52,27 +99,40 @@ bool AShooterPickup::CanBePickedUp(class AShooterCharacter* TestPawn) const
 	return TestPawn && TestPawn->IsAlive();
 }
 
+UClass* AShooterPickup::GetWeaponType() const
+{
+	return NULL;
+}
+
 void AShooterPickup::GivePickupTo(class AShooterCharacter* Pawn)
 {
 }
 
 void AShooterPickup::PickupOnTouch(class AShooterCharacter* Pawn)
 {
-	if (bIsActive && Pawn && Pawn->IsAlive() && !IsPendingKill())
+	// clients only learn about pickups through the replicated bitfield
+	if (HasAuthority() && bIsActive && Pawn && Pawn->IsAlive() && !IsPendingKill())
 	{
 		if (CanBePickedUp(Pawn))
 		{
 			GivePickupTo(Pawn);
 			PickedUpBy = Pawn;
 
+			UShooterMatchLog* MatchLog = UShooterMatchLog::Get(this);
+			if (MatchLog)
+			{
+				MatchLog->Record(EShooterMatchEvent::Pickup, Pawn->GetPlayerState(), NULL, 0.0f, GetActorLocation());
+			}
+
 			if (!IsPendingKill())
 			{
 				bIsActive = false;
 				OnPickedUp();
 
-				if (RespawnTime > 0.0f)
+				AShooterGameState* MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+				if (MyGameState && RespawnTime > 0.0f)
 				{
-					GetWorldTimerManager().SetTimer(TimerHandle_RespawnPickup, this, &AShooterPickup::RespawnPickup, RespawnTime, false);
+					MyGameState->GetPickupManager().ScheduleRespawn(this, RespawnTime);
 				}
 			}
 		}
@@ -85,17 +145,86 @@ void AShooterPickup::RespawnPickup()
 	PickedUpBy = NULL;
 	OnRespawned();
 
-	TSet<AActor*> OverlappingPawns;
-	GetOverlappingActors(OverlappingPawns, AShooterCharacter::StaticClass());
+	// pawns already standing on the pickup, from the registry grid instead of an overlap query
+	UShooterPawnRegistry* PawnRegistry = GetWorld()->GetSubsystem<UShooterPawnRegistry>();
+	UCapsuleComponent* CollisionComp = Cast<UCapsuleComponent>(GetRootComponent());
+	if (PawnRegistry && CollisionComp)
+	{
+		const FVector PickupLocation = CollisionComp->GetComponentLocation();
+		const float PickupRadius = CollisionComp->GetScaledCapsuleRadius();
+		const float PickupHalfHeight = CollisionComp->GetScaledCapsuleHalfHeight();
+
+		TArray<int32> OverlappingIndices;
+		PawnRegistry->FindInRadius(PickupLocation, PickupRadius + PawnRegistry->GetMaxCapsuleRadius(), [&](int32 Idx)
+		{
+			const FVector& PawnLocation = PawnRegistry->GetLocation(Idx);
+			return PawnRegistry->IsAlive(Idx)
+				&& FMath::Abs(PickupLocation.Z - PawnLocation.Z) < PickupHalfHeight + PawnRegistry->GetCapsuleHalfHeight(Idx)
+				&& (PickupLocation - PawnLocation).Size2D() < PickupRadius + PawnRegistry->GetCapsuleRadius(Idx);
+		}, OverlappingIndices);
+
+		for (int32 Idx : OverlappingIndices)
+		{
+			PickupOnTouch(PawnRegistry->GetCharacter(Idx));
+		}
+	}
+}
+
+void AShooterPickup::SetActiveFromReplication(bool bActive)
+{
+	if (bIsActive == bActive)
+	{
+		return;
+	}
+
+	bIsActive = bActive;
+	if (bIsActive)
+	{
+		PickedUpBy = NULL;
+		OnRespawned();
+	}
+	else
+	{
+		// the picker is only known when it's one of our own players
+		PickedUpBy = NULL;
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			APlayerController* PC = It->Get();
+			AShooterCharacter* LocalPawn = (PC && PC->IsLocalController()) ? Cast<AShooterCharacter>(PC->GetPawn()) : NULL;
+			if (LocalPawn && IsOverlappingActor(LocalPawn))
+			{
+				PickedUpBy = LocalPawn;
+				break;
+			}
+		}
+		OnPickedUp();
+	}
+}
+
+void AShooterPickup::UpdateAvailability()
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
 
-	for (AActor* OverlappingPawn : OverlappingPawns)
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (GameMode)
+	{
+		GameMode->GetPickupIndex().SetAvailable(this, bIsActive);
+	}
+
+	AShooterGameState* MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (MyGameState)
 	{
-		PickupOnTouch(CastChecked<AShooterCharacter>(OverlappingPawn));	
+		MyGameState->GetPickupManager().SetAvailable(this, bIsActive);
 	}
 }
 
 void AShooterPickup::OnPickedUp()
 {
+	UpdateAvailability();
+
 	if (RespawningFX)
 	{
 		PickupPSC->SetTemplate(RespawningFX);
@@ -116,6 +245,8 @@ void AShooterPickup::OnPickedUp()
 
 void AShooterPickup::OnRespawned()
 {
+	UpdateAvailability();
+
 	if (ActiveFX)
 	{
 		PickupPSC->SetTemplate(ActiveFX);
@@ -134,23 +265,3 @@ void AShooterPickup::OnRespawned()
 
 	OnRespawnEvent();
 }
-
-void AShooterPickup::OnRep_IsActive()
-{
-	if (bIsActive)
-	{
-		OnRespawned();
-	}
-	else
-	{
-		OnPickedUp();
-	}
-}
-
-void AShooterPickup::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
-{
-	Super::GetLifetimeReplicatedProps( OutLifetimeProps );
-
-	DOREPLIFETIME( AShooterPickup, bIsActive );
-	DOREPLIFETIME( AShooterPickup, PickedUpBy );
-}
\ No newline at end of file
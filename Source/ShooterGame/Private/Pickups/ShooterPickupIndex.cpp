@@ -0,0 +1,242 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Pickups/ShooterPickupIndex.h"
+#include "Pickups/ShooterPickup.h"
+#include "NavigationSystem.h"
+#include "Algo/BinarySearch.h"
+
+/** size of cells path costs are cached for */
+static const float PickupPathCostCellSize = 500.0f;
+
+/** number of closest pickups compared by path length */
+static const int32 PickupPathCostCandidates = 3;
+
+/** max start cells path costs are cached for per pickup, the cache of a pickup is dropped when it fills up */
+static const int32 PickupPathCostMaxStarts = 256;
+
+/** size of grid cells pickups are bucketed in */
+static const float PickupIndexCellSize = 2000.0f;
+
+FIntPoint FShooterPickupIndex::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / PickupIndexCellSize), FMath::FloorToInt(Location.Y / PickupIndexCellSize));
+}
+
+void FShooterPickupIndex::AddPickup(AShooterPickup* Pickup)
+{
+	if (Pickup == NULL || PickupBuckets.Contains(Pickup))
+	{
+		return;
+	}
+
+	UClass* PickupClass = Pickup->GetClass();
+	UClass* WeaponClass = Pickup->GetWeaponType();
+
+	int32 BucketIdx = Buckets.IndexOfByPredicate([&](const FBucket& Bucket)
+	{
+		return Bucket.PickupClass == PickupClass && Bucket.WeaponClass == WeaponClass;
+	});
+
+	const FIntPoint Cell = GetCell(Pickup->GetActorLocation());
+	if (BucketIdx == INDEX_NONE)
+	{
+		BucketIdx = Buckets.AddDefaulted();
+		Buckets[BucketIdx].PickupClass = PickupClass;
+		Buckets[BucketIdx].WeaponClass = WeaponClass;
+		Buckets[BucketIdx].MinCell = Cell;
+		Buckets[BucketIdx].MaxCell = Cell;
+	}
+
+	FBucket& Bucket = Buckets[BucketIdx];
+	Bucket.Pickups.Add(Pickup);
+	Bucket.MinCell = FIntPoint(FMath::Min(Bucket.MinCell.X, Cell.X), FMath::Min(Bucket.MinCell.Y, Cell.Y));
+	Bucket.MaxCell = FIntPoint(FMath::Max(Bucket.MaxCell.X, Cell.X), FMath::Max(Bucket.MaxCell.Y, Cell.Y));
+	PickupBuckets.Add(Pickup, BucketIdx);
+
+	SetAvailable(Pickup, Pickup->IsActive());
+}
+
+void FShooterPickupIndex::SetAvailable(AShooterPickup* Pickup, bool bAvailable)
+{
+	const int32* BucketIdx = PickupBuckets.Find(Pickup);
+	if (BucketIdx == NULL)
+	{
+		return;
+	}
+
+	// level pickups don't move, so the cell they were added in stays valid
+	FBucket& Bucket = Buckets[*BucketIdx];
+	const FIntPoint Cell = GetCell(Pickup->GetActorLocation());
+	if (bAvailable)
+	{
+		TArray<AShooterPickup*>& CellPickups = Bucket.AvailableCells.FindOrAdd(Cell);
+		if (!CellPickups.Contains(Pickup))
+		{
+			CellPickups.Add(Pickup);
+			Bucket.NumAvailable++;
+		}
+	}
+	else
+	{
+		TArray<AShooterPickup*>* CellPickups = Bucket.AvailableCells.Find(Cell);
+		if (CellPickups && CellPickups->RemoveSingleSwap(Pickup) > 0)
+		{
+			Bucket.NumAvailable--;
+			if (CellPickups->Num() == 0)
+			{
+				Bucket.AvailableCells.Remove(Cell);
+			}
+		}
+	}
+}
+
+void FShooterPickupIndex::RemovePickup(AShooterPickup* Pickup)
+{
+	const int32* BucketIdx = PickupBuckets.Find(Pickup);
+	if (BucketIdx == NULL)
+	{
+		return;
+	}
+
+	SetAvailable(Pickup, false);
+	Buckets[*BucketIdx].Pickups.RemoveSingleSwap(Pickup);
+	PickupBuckets.Remove(Pickup);
+	PathCosts.Remove(Pickup);
+}
+
+AShooterPickup* FShooterPickupIndex::FindNearestAvailable(UClass* PickupType, UClass* WeaponType, AShooterCharacter* ForPawn, bool bUsePathCost)
+{
+	if (ForPawn == NULL)
+	{
+		return NULL;
+	}
+
+	const FVector Origin = ForPawn->GetActorLocation();
+	const FIntPoint Center = GetCell(Origin);
+
+	// closest first, only PickupPathCostCandidates are kept when comparing path costs
+	TArray<TPair<float, AShooterPickup*>, TInlineAllocator<PickupPathCostCandidates + 1>> Candidates;
+	const int32 MaxCandidates = bUsePathCost ? PickupPathCostCandidates : 1;
+
+	auto VisitCell = [&](const FBucket& Bucket, int32 X, int32 Y)
+	{
+		const TArray<AShooterPickup*>* CellPickups = Bucket.AvailableCells.Find(FIntPoint(X, Y));
+		if (CellPickups == NULL)
+		{
+			return;
+		}
+
+		for (AShooterPickup* Pickup : *CellPickups)
+		{
+			const float DistSq = FVector::DistSquared(Pickup->GetActorLocation(), Origin);
+			if ((Candidates.Num() < MaxCandidates || DistSq < Candidates.Last().Key) && Pickup->CanBePickedUp(ForPawn))
+			{
+				const int32 InsertIdx = Algo::LowerBoundBy(Candidates, DistSq, [](const TPair<float, AShooterPickup*>& Candidate) { return Candidate.Key; });
+				Candidates.Insert(TPair<float, AShooterPickup*>(DistSq, Pickup), InsertIdx);
+				if (Candidates.Num() > MaxCandidates)
+				{
+					Candidates.Pop(false);
+				}
+			}
+		}
+	};
+
+	for (const FBucket& Bucket : Buckets)
+	{
+		if (Bucket.NumAvailable == 0
+			|| (PickupType && !Bucket.PickupClass->IsChildOf(PickupType))
+			|| (WeaponType && (Bucket.WeaponClass == NULL || !Bucket.WeaponClass->IsChildOf(WeaponType))))
+		{
+			continue;
+		}
+
+		// rings of cells around the pawn, until the bucket's bounds are covered or nothing closer can be left
+		const int32 MaxRing = FMath::Max3(FMath::Abs(Center.X - Bucket.MinCell.X), FMath::Abs(Center.X - Bucket.MaxCell.X), FMath::Max(FMath::Abs(Center.Y - Bucket.MinCell.Y), FMath::Abs(Center.Y - Bucket.MaxCell.Y)));
+		for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+		{
+			const float RingDistSq = FMath::Square(FMath::Max(Ring - 1, 0) * PickupIndexCellSize);
+			if (Candidates.Num() >= MaxCandidates && Candidates.Last().Key <= RingDistSq)
+			{
+				break;
+			}
+
+			if (Ring == 0)
+			{
+				VisitCell(Bucket, Center.X, Center.Y);
+				continue;
+			}
+
+			for (int32 X = Center.X - Ring; X <= Center.X + Ring; X++)
+			{
+				VisitCell(Bucket, X, Center.Y - Ring);
+				VisitCell(Bucket, X, Center.Y + Ring);
+			}
+			for (int32 Y = Center.Y - Ring + 1; Y <= Center.Y + Ring - 1; Y++)
+			{
+				VisitCell(Bucket, Center.X - Ring, Y);
+				VisitCell(Bucket, Center.X + Ring, Y);
+			}
+		}
+	}
+
+	if (!bUsePathCost)
+	{
+		return Candidates.Num() > 0 ? Candidates[0].Value : NULL;
+	}
+
+	AShooterPickup* BestPickup = NULL;
+	float BestCost = MAX_FLT;
+	for (const TPair<float, AShooterPickup*>& Candidate : Candidates)
+	{
+		const float Cost = GetPathCost(ForPawn, Candidate.Value);
+		if (Cost >= 0.0f && Cost < BestCost)
+		{
+			BestCost = Cost;
+			BestPickup = Candidate.Value;
+		}
+	}
+
+	return BestPickup;
+}
+
+float FShooterPickupIndex::GetPathCost(AShooterCharacter* ForPawn, AShooterPickup* Pickup)
+{
+	const FVector Start = ForPawn->GetActorLocation();
+	const FIntVector StartCell(FMath::FloorToInt(Start.X / PickupPathCostCellSize), FMath::FloorToInt(Start.Y / PickupPathCostCellSize), FMath::FloorToInt(Start.Z / PickupPathCostCellSize));
+
+	TMap<FIntVector, float>& PickupCosts = PathCosts.FindOrAdd(Pickup);
+	const float* CachedCost = PickupCosts.Find(StartCell);
+	if (CachedCost)
+	{
+		return *CachedCost;
+	}
+
+	float Cost = -1.0f;
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(ForPawn->GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : NULL;
+	if (NavData)
+	{
+		FPathFindingQuery Query(ForPawn, *NavData, Start, Pickup->GetActorLocation());
+		const FPathFindingResult Result = NavSys->FindPathSync(Query);
+		if (Result.IsSuccessful() && Result.Path.IsValid())
+		{
+			Cost = static_cast<float>(Result.Path->GetLength());
+		}
+	}
+
+	if (PickupCosts.Num() >= PickupPathCostMaxStarts)
+	{
+		PickupCosts.Reset();
+	}
+
+	PickupCosts.Add(StartCell, Cost);
+	return Cost;
+}
+
+void FShooterPickupIndex::Reset()
+{
+	Buckets.Reset();
+	PickupBuckets.Reset();
+	PathCosts.Reset();
+}
@@ -0,0 +1,178 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Pickups/ShooterPickupManager.h"
+#include "Pickups/ShooterPickup.h"
+
+FShooterPickupManager::FShooterPickupManager()
+	: bPickupsDirty(false)
+	, Owner(NULL)
+{
+}
+
+void FShooterPickupManager::Initialize(AShooterGameState* InOwner)
+{
+	Owner = InOwner;
+}
+
+void FShooterPickupManager::RegisterPickup(AShooterPickup* Pickup)
+{
+	if (Pickup == NULL || Owner == NULL || Pickups.Contains(Pickup))
+	{
+		return;
+	}
+
+	Pickups.Add(Pickup);
+	ScheduleRefresh();
+}
+
+void FShooterPickupManager::UnregisterPickup(AShooterPickup* Pickup)
+{
+	if (Owner == NULL || Pickups.Remove(Pickup) == 0)
+	{
+		return;
+	}
+
+	PickupIndices.Remove(Pickup);
+	CancelRespawn(Pickup);
+	ScheduleRefresh();
+}
+
+void FShooterPickupManager::ScheduleRefresh()
+{
+	if (!bPickupsDirty)
+	{
+		bPickupsDirty = true;
+		Owner->GetWorldTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(Owner, [this]() { RefreshPickups(); }));
+	}
+}
+
+void FShooterPickupManager::RefreshPickups()
+{
+	if (!bPickupsDirty)
+	{
+		return;
+	}
+
+	bPickupsDirty = false;
+
+	// level pickups have the same path names everywhere, keep them in that order
+	Pickups.Sort([](const AShooterPickup& A, const AShooterPickup& B) { return A.GetPathName() < B.GetPathName(); });
+
+	PickupIndices.Reset();
+	for (int32 i = 0; i < Pickups.Num(); i++)
+	{
+		PickupIndices.Add(Pickups[i], i);
+	}
+
+	if (Owner->HasAuthority())
+	{
+		FShooterPickupAvailability& Availability = Owner->GetPickupAvailability();
+		Availability.NumPickups = Pickups.Num();
+		Availability.Bits.Init(0, FMath::DivideAndRoundUp(Pickups.Num(), 32));
+		for (int32 i = 0; i < Pickups.Num(); i++)
+		{
+			Availability.SetAvailable(i, Pickups[i]->IsActive());
+		}
+	}
+	else
+	{
+		ApplyAvailability();
+	}
+}
+
+void FShooterPickupManager::SetAvailable(AShooterPickup* Pickup, bool bAvailable)
+{
+	if (bPickupsDirty)
+	{
+		// whole bitfield is rebuilt from the pickups on refresh
+		return;
+	}
+
+	const int32* PickupIdx = PickupIndices.Find(Pickup);
+	if (PickupIdx && Owner->HasAuthority())
+	{
+		Owner->GetPickupAvailability().SetAvailable(*PickupIdx, bAvailable);
+	}
+}
+
+void FShooterPickupManager::ScheduleRespawn(AShooterPickup* Pickup, float Delay)
+{
+	if (Pickup == NULL || Owner == NULL)
+	{
+		return;
+	}
+
+	FPendingRespawn PendingRespawn;
+	PendingRespawn.Time = Owner->GetWorld()->GetTimeSeconds() + Delay;
+	PendingRespawn.Pickup = Pickup;
+	RespawnQueue.HeapPush(PendingRespawn);
+
+	UpdateRespawnTimer();
+}
+
+void FShooterPickupManager::CancelRespawn(AShooterPickup* Pickup)
+{
+	const int32 NumRemoved = RespawnQueue.RemoveAll([Pickup](const FPendingRespawn& PendingRespawn)
+	{
+		return !PendingRespawn.Pickup.IsValid() || PendingRespawn.Pickup.Get() == Pickup;
+	});
+
+	if (NumRemoved > 0)
+	{
+		RespawnQueue.Heapify();
+		UpdateRespawnTimer();
+	}
+}
+
+void FShooterPickupManager::ApplyAvailability()
+{
+	if (bPickupsDirty)
+	{
+		// applied on refresh, once indices are rebuilt
+		return;
+	}
+
+	const FShooterPickupAvailability& Availability = Owner->GetPickupAvailability();
+	if (Availability.NumPickups != Pickups.Num())
+	{
+		// not all pickups registered yet
+		return;
+	}
+
+	for (int32 i = 0; i < Pickups.Num(); i++)
+	{
+		Pickups[i]->SetActiveFromReplication(Availability.IsAvailable(i));
+	}
+}
+
+void FShooterPickupManager::ProcessRespawns()
+{
+	const float Now = Owner->GetWorld()->GetTimeSeconds();
+	while (RespawnQueue.Num() > 0 && RespawnQueue.HeapTop().Time <= Now)
+	{
+		FPendingRespawn PendingRespawn;
+		RespawnQueue.HeapPop(PendingRespawn, false);
+
+		AShooterPickup* Pickup = PendingRespawn.Pickup.Get();
+		if (Pickup)
+		{
+			Pickup->RespawnPickup();
+		}
+	}
+
+	UpdateRespawnTimer();
+}
+
+void FShooterPickupManager::UpdateRespawnTimer()
+{
+	FTimerManager& TimerManager = Owner->GetWorldTimerManager();
+	if (RespawnQueue.Num() == 0)
+	{
+		TimerManager.ClearTimer(TimerHandle_ProcessRespawns);
+		return;
+	}
+
+	const float Delay = FMath::Max(RespawnQueue.HeapTop().Time - Owner->GetWorld()->GetTimeSeconds(), KINDA_SMALL_NUMBER);
+	TimerManager.SetTimer(TimerHandle_ProcessRespawns, FTimerDelegate::CreateWeakLambda(Owner, [this]() { ProcessRespawns(); }), Delay, false);
+}
@@ -9,6 +9,12 @@
 #include "Animation/AnimInstance.h"
 #include "Sound/SoundNodeLocalPlayer.h"
 #include "AudioThread.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "IAnimationBudgetAllocator.h"
+#include "Player/ShooterCorpseManager.h"
+#include "Player/ShooterPawnRegistry.h"
+#include "Player/ShooterTeamMaterials.h"
+#include "Engine/AssetManager.h"
 
 static int32 NetVisualizeRelevancyTestPoints = 0;
 FAutoConsoleVariableRef CVarNetVisualizeRelevancyTestPoints(
@@ -27,11 +33,22 @@ FAutoConsoleVariableRef CVarNetEnablePauseRelevancy(
 	TEXT("0: Disable, 1: Enable"),
 	ECVF_Cheat);
 
+static int32 AnimBudgetRemoteCharacters = 1;
+FAutoConsoleVariableRef CVarAnimBudgetRemoteCharacters(
+	TEXT("p.AnimBudgetRemoteCharacters"),
+	AnimBudgetRemoteCharacters,
+	TEXT("Register third person meshes of remote characters with the animation budget allocator (see a.Budget.*)\n")
+	TEXT("0: Disable, 1: Enable"),
+	ECVF_Default);
+
 FOnShooterCharacterEquipWeapon AShooterCharacter::NotifyEquipWeapon;
 FOnShooterCharacterUnEquipWeapon AShooterCharacter::NotifyUnEquipWeapon;
+FOnShooterCharacterInventoryWeapon AShooterCharacter::NotifyAddInventoryWeapon;
+FOnShooterCharacterInventoryWeapon AShooterCharacter::NotifyRemoveInventoryWeapon;
 
 AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer)
-	: Super(ObjectInitializer.SetDefaultSubobjectClass<UShooterCharacterMovement>(ACharacter::CharacterMovementComponentName))
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UShooterCharacterMovement>(ACharacter::CharacterMovementComponentName)
+		.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
 #pragma region camera, mesh
 	// root - camera3p
@@ -72,6 +89,10 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 	GetMesh()->SetCollisionResponseToChannel(COLLISION_PROJECTILE, ECR_Block);
 	GetMesh()->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
 
+	// registered manually once we know whether this pawn is remote, see UpdateAnimationBudget
+	CastChecked<USkeletalMeshComponentBudgeted>(GetMesh())->SetAutoRegisterWithBudgetAllocator(false);
+	bAnimationBudgeted = false;
+	bMeshPausedByReplication = false;
 
 #pragma endregion
 
@@ -96,6 +117,8 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 	SprintingSpeedModifier = 1.5f;
 	bWantsToSprint = false;
 	LowHealthPercentage = 0.5f;
+	bTeamColorFromPrimitiveData = false;
+	TeamColorPrimitiveDataIndex = 0;
 
 	BaseTurnRate = 45.f;
 	BaseLookUpRate = 45.f;
@@ -105,6 +128,7 @@ void AShooterCharacter::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
+
 	if (GetLocalRole() == ROLE_Authority)
 	{
 		Health = GetMaxHealth();
@@ -117,25 +141,95 @@ void AShooterCharacter::PostInitializeComponents()
 	UpdatePawnMeshes();
 	StartingThirdPersonMeshLocation = GetMesh()->GetRelativeLocation();
 
-	// create material instance for setting team colors (3rd person view)
-	for (int32 iMat = 0; iMat < GetMesh()->GetNumMaterials(); iMat++)
+	if (GetNetMode() == NM_DedicatedServer)
 	{
-		MeshMIDs.Add(GetMesh()->CreateAndSetMaterialInstanceDynamic(iMat));
+		// first person mesh is never seen on server
+		Mesh1P->SetComponentTickEnabled(false);
+		Mesh1P->UnregisterComponent();
 	}
-
-	// play respawn effects
-	if (GetNetMode() != NM_DedicatedServer)
+	else
 	{
-		if (RespawnFX)
+		TArray<FSoftObjectPath> CosmeticAssets;
+		for (const FSoftObjectPath& Asset : { RespawnFX.ToSoftObjectPath(), RespawnSound.ToSoftObjectPath(), DeathSound.ToSoftObjectPath(), LowHealthSound.ToSoftObjectPath(), RunLoopSound.ToSoftObjectPath(), RunStopSound.ToSoftObjectPath(), TargetingSound.ToSoftObjectPath() })
+		{
+			if (!Asset.IsNull())
+			{
+				CosmeticAssets.AddUnique(Asset);
+			}
+		}
+
+		// respawn effects play as soon as the handle completes, right away once the first character loaded them
+		if (CosmeticAssets.Num() > 0)
 		{
-			UGameplayStatics::SpawnEmitterAtLocation(this, RespawnFX, GetActorLocation(), GetActorRotation());
+			CosmeticAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(CosmeticAssets, FStreamableDelegate::CreateUObject(this, &AShooterCharacter::PlayRespawnEffects));
 		}
+	}
+}
+
+void AShooterCharacter::PlayRespawnEffects()
+{
+	if (IsPendingKill())
+	{
+		return;
+	}
+
+	UParticleSystem* RespawnFXAsset = RespawnFX.Get();
+	if (RespawnFXAsset)
+	{
+		UGameplayStatics::SpawnEmitterAtLocation(this, RespawnFXAsset, GetActorLocation(), GetActorRotation());
+	}
+
+	USoundCue* RespawnSoundAsset = RespawnSound.Get();
+	if (RespawnSoundAsset)
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, RespawnSoundAsset, GetActorLocation());
+	}
+}
+
+void AShooterCharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UpdateAnimationBudget();
+
+	UShooterPawnRegistry* PawnRegistry = GetWorld()->GetSubsystem<UShooterPawnRegistry>();
+	if (PawnRegistry)
+	{
+		PawnRegistry->RegisterCharacter(this);
+	}
+}
 
-		if (RespawnSound)
+void AShooterCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bAnimationBudgeted)
+	{
+		IAnimationBudgetAllocator* BudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld());
+		if (BudgetAllocator)
 		{
-			UGameplayStatics::PlaySoundAtLocation(this, RespawnSound, GetActorLocation());
+			BudgetAllocator->UnregisterComponent(CastChecked<USkeletalMeshComponentBudgeted>(GetMesh()));
 		}
+		bAnimationBudgeted = false;
+	}
+
+	UShooterCorpseManager* CorpseManager = GetWorld() ? GetWorld()->GetSubsystem<UShooterCorpseManager>() : NULL;
+	if (CorpseManager)
+	{
+		CorpseManager->UnregisterCorpse(this);
+	}
+
+	UShooterPawnRegistry* PawnRegistry = GetWorld() ? GetWorld()->GetSubsystem<UShooterPawnRegistry>() : NULL;
+	if (PawnRegistry)
+	{
+		PawnRegistry->UnregisterCharacter(this);
+	}
+
+	if (CosmeticAssetsHandle.IsValid())
+	{
+		CosmeticAssetsHandle->ReleaseHandle();
+		CosmeticAssetsHandle.Reset();
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AShooterCharacter::PossessedBy(class AController* InController)
@@ -143,9 +237,10 @@ void AShooterCharacter::PossessedBy(class AController* InController)
 	Super::PossessedBy(InController);
 
 	// [server] as soon as PlayerState is assigned, set team colors of this pawn for local player
-	UpdateTeamColorsAllMIDs();
+	UpdateTeamColors();
 
 	InitView();
+	UpdateAnimationBudget();
 }
 
 void AShooterCharacter::Destroyed()
@@ -161,12 +256,14 @@ void AShooterCharacter::PawnClientRestart()
 	// switch mesh to 1st person view
 	UpdatePawnMeshes();
 
+	// locally controlled pawn always animates at full rate
+	UpdateAnimationBudget();
+
 	// reattach weapon if needed
 	SetCurrentWeapon(CurrentWeapon);
 
 	// set team colors for 1st person view
-	UMaterialInstanceDynamic* Mesh1PMID = Mesh1P->CreateAndSetMaterialInstanceDynamic(0);
-	UpdateTeamColors(Mesh1PMID);
+	UpdateTeamColors();
 }
 
 void AShooterCharacter::OnRep_PlayerState()
@@ -176,7 +273,7 @@ void AShooterCharacter::OnRep_PlayerState()
 	// [client] as soon as PlayerState is assigned, set team colors of this pawn for local player
 	if (GetPlayerState() != NULL)
 	{
-		UpdateTeamColorsAllMIDs();
+		UpdateTeamColors();
 	}
 
 }
@@ -186,6 +283,7 @@ void AShooterCharacter::OnRep_Controller()
 	Super::OnRep_Controller();
 
 	InitView();
+	UpdateAnimationBudget();
 }
 
 FRotator AShooterCharacter::GetAimOffsets() const
@@ -237,7 +335,19 @@ void AShooterCharacter::UpdatePawnMeshes()
 	Mesh1P->SetOwnerNoSee(!bFirstPerson);
 
 	//GetMesh()->SetVisibility(!bFirstPerson, true);
-	GetMesh()->VisibilityBasedAnimTickOption = bFirstPerson ? EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered : EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	if (bFirstPerson)
+	{
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	}
+	else if (GetLocalRole() == ROLE_SimulatedProxy)
+	{
+		// remote characters only need montages (notifies, death anim) while off-screen
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	}
+	else
+	{
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	}
 	GetMesh()->SetOwnerNoSee(bFirstPerson);
 
 	if (CurrentWeapon)
@@ -246,16 +356,64 @@ void AShooterCharacter::UpdatePawnMeshes()
 	}
 }
 
-void AShooterCharacter::UpdateTeamColors(UMaterialInstanceDynamic* UseMID)
+void AShooterCharacter::UpdateAnimationBudget()
 {
-	if (UseMID)
+	USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+	if (BudgetedMesh == NULL || GetWorld() == NULL || !HasActorBegunPlay())
+	{
+		return;
+	}
+
+	// local pawn, dying pawns (ragdoll blend) and server side meshes keep full update rate, paused meshes don't update at all
+	const bool bWantsBudget = (AnimBudgetRemoteCharacters == 1)
+		&& GetNetMode() != NM_DedicatedServer
+		&& !IsLocallyControlled()
+		&& !bIsDying
+		&& !bMeshPausedByReplication;
+
+	if (bWantsBudget == bAnimationBudgeted)
+	{
+		return;
+	}
+
+	IAnimationBudgetAllocator* BudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (BudgetAllocator)
 	{
-		AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(GetPlayerState());
-		if (MyPlayerState != NULL)
+		if (bWantsBudget)
+		{
+			BudgetAllocator->RegisterComponent(BudgetedMesh);
+		}
+		else
 		{
-			float MaterialParam = (float)MyPlayerState->GetTeamNum();
-			UseMID->SetScalarParameterValue(TEXT("Team Color Index"), MaterialParam);
+			BudgetAllocator->UnregisterComponent(BudgetedMesh);
 		}
+
+		bAnimationBudgeted = bWantsBudget;
+	}
+}
+
+void AShooterCharacter::UpdateTeamColors()
+{
+	AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(GetPlayerState());
+	if (MyPlayerState == NULL || GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	const int32 TeamNum = MyPlayerState->GetTeamNum();
+	if (bTeamColorFromPrimitiveData)
+	{
+		GetMesh()->SetCustomPrimitiveDataFloat(TeamColorPrimitiveDataIndex, (float)TeamNum);
+		Mesh1P->SetCustomPrimitiveDataFloat(TeamColorPrimitiveDataIndex, (float)TeamNum);
+		return;
+	}
+
+	// materials still use the "Team Color Index" parameter, share one instance per team instead of one per pawn
+	UShooterTeamMaterials* TeamMaterials = GetWorld()->GetSubsystem<UShooterTeamMaterials>();
+	if (TeamMaterials)
+	{
+		TeamMaterials->ApplyTeamColor(GetMesh(), TeamNum);
+		TeamMaterials->ApplyTeamColor(Mesh1P, TeamNum);
 	}
 }
 
@@ -396,6 +554,9 @@ void AShooterCharacter::OnDeath(float KillingDamage, struct FDamageEvent const&
 	TearOff();
 	bIsDying = true;
 
+	// ragdoll blending needs a full rate pose, take the mesh out of the budget
+	UpdateAnimationBudget();
+
 	if (GetLocalRole() == ROLE_Authority)
 	{
 		ReplicateHit(KillingDamage, DamageEvent, PawnInstigator, DamageCauser, true);
@@ -415,9 +576,9 @@ void AShooterCharacter::OnDeath(float KillingDamage, struct FDamageEvent const&
 	}
 
 	// cannot use IsLocallyControlled here, because even local client's controller may be NULL here
-	if (GetNetMode() != NM_DedicatedServer && DeathSound && Mesh1P && Mesh1P->IsVisible())
+	if (GetNetMode() != NM_DedicatedServer && DeathSound.Get() && Mesh1P && Mesh1P->IsVisible())
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, DeathSound, GetActorLocation());
+		UGameplayStatics::PlaySoundAtLocation(this, DeathSound.Get(), GetActorLocation());
 	}
 
 	// remove all weapons
@@ -553,6 +714,13 @@ void AShooterCharacter::SetRagdollPhysics()
 	else
 	{
 		SetLifeSpan(10.0f);
+
+		// may freeze or recycle other corpses (including this one) to stay in budget
+		UShooterCorpseManager* CorpseManager = GetWorld()->GetSubsystem<UShooterCorpseManager>();
+		if (CorpseManager)
+		{
+			CorpseManager->RegisterCorpse(this);
+		}
 	}
 }
 
@@ -579,7 +747,9 @@ void AShooterCharacter::ReplicateHit(float Damage, struct FDamageEvent const& Da
 	LastTakeHitInfo.ActualDamage = Damage;
 	LastTakeHitInfo.PawnInstigator = Cast<AShooterCharacter>(PawnInstigator);
 	LastTakeHitInfo.DamageCauser = DamageCauser;
+	LastTakeHitInfo.VictimLocation = GetActorLocation();
 	LastTakeHitInfo.SetDamageEvent(DamageEvent);
+	LastTakeHitInfo.UpdateDamageTypeIndex(this);
 	LastTakeHitInfo.bKilled = bKilled;
 	LastTakeHitInfo.EnsureReplication();
 
@@ -588,6 +758,8 @@ void AShooterCharacter::ReplicateHit(float Damage, struct FDamageEvent const& Da
 
 void AShooterCharacter::OnRep_LastTakeHitInfo()
 {
+	LastTakeHitInfo.ResolveDamageTypeClass(this);
+
 	if (LastTakeHitInfo.bKilled)
 	{
 		OnDeath(LastTakeHitInfo.ActualDamage, LastTakeHitInfo.GetDamageEvent(), LastTakeHitInfo.PawnInstigator.Get(), LastTakeHitInfo.DamageCauser.Get());
@@ -662,7 +834,10 @@ void AShooterCharacter::AddWeapon(AShooterWeapon* Weapon)
 	if (Weapon && GetLocalRole() == ROLE_Authority)
 	{
 		Weapon->OnEnterInventory(this);
-		Inventory.AddUnique(Weapon);
+		if (Inventory.AddUnique(Weapon))
+		{
+			OnInventoryWeaponAdded(Weapon);
+		}
 	}
 }
 
@@ -671,10 +846,99 @@ void AShooterCharacter::RemoveWeapon(AShooterWeapon* Weapon)
 	if (Weapon && GetLocalRole() == ROLE_Authority)
 	{
 		Weapon->OnLeaveInventory();
-		Inventory.RemoveSingle(Weapon);
+		if (Inventory.IndexOfByKey(Weapon) != INDEX_NONE)
+		{
+			OnInventoryWeaponRemoved(Weapon);
+			Inventory.RemoveSingle(Weapon);
+		}
 	}
 }
 
+void AShooterCharacter::OnInventoryWeaponAdded(AShooterWeapon* Weapon)
+{
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		NotifyAddInventoryWeapon.Broadcast(this, Weapon);
+	}
+}
+
+void AShooterCharacter::OnInventoryWeaponRemoved(AShooterWeapon* Weapon)
+{
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		NotifyRemoveInventoryWeapon.Broadcast(this, Weapon);
+	}
+}
+
+bool FShooterInventoryList::AddUnique(AShooterWeapon* Weapon)
+{
+	if (Weapon == nullptr || IndexOfByKey(Weapon) != INDEX_NONE)
+	{
+		return false;
+	}
+
+	FShooterInventoryEntry& NewEntry = Entries.AddDefaulted_GetRef();
+	NewEntry.Weapon = Weapon;
+	NewEntry.Slot = NextSlot++;
+	MarkItemDirty(NewEntry);
+	MarkSlotOrderDirty();
+
+	return true;
+}
+
+bool FShooterInventoryList::RemoveSingle(AShooterWeapon* Weapon)
+{
+	const int32 EntryIndex = Entries.IndexOfByPredicate([Weapon](const FShooterInventoryEntry& Entry) { return Entry.Weapon == Weapon; });
+	if (EntryIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// weapon cycling goes by Slot, entry order doesn't matter
+	Entries.RemoveAtSwap(EntryIndex);
+	MarkArrayDirty();
+	MarkSlotOrderDirty();
+
+	return true;
+}
+
+int32 FShooterInventoryList::IndexOfByKey(const AShooterWeapon* Weapon) const
+{
+	return GetSlotOrder().IndexOfByPredicate([this, Weapon](int32 EntryIndex) { return Entries[EntryIndex].Weapon == Weapon; });
+}
+
+const TArray<int32>& FShooterInventoryList::GetSlotOrder() const
+{
+	if (bSlotOrderDirty || SlotOrder.Num() != Entries.Num())
+	{
+		bSlotOrderDirty = false;
+
+		SlotOrder.Reset(Entries.Num());
+		for (int32 i = 0; i < Entries.Num(); i++)
+		{
+			SlotOrder.Add(i);
+		}
+		SlotOrder.Sort([this](int32 A, int32 B) { return Entries[A].Slot < Entries[B].Slot; });
+	}
+
+	return SlotOrder;
+}
+
+void FShooterInventoryEntry::PreReplicatedRemove(const FShooterInventoryList& InArraySerializer)
+{
+	InArraySerializer.MarkSlotOrderDirty();
+}
+
+void FShooterInventoryEntry::PostReplicatedAdd(const FShooterInventoryList& InArraySerializer)
+{
+	InArraySerializer.MarkSlotOrderDirty();
+}
+
+void FShooterInventoryEntry::PostReplicatedChange(const FShooterInventoryList& InArraySerializer)
+{
+	InArraySerializer.MarkSlotOrderDirty();
+}
+
 AShooterWeapon* AShooterCharacter::FindWeapon(TSubclassOf<AShooterWeapon> WeaponClass)
 {
 	for (int32 i = 0; i < Inventory.Num(); i++)
@@ -774,25 +1038,12 @@ void AShooterCharacter::SetTargeting(bool bNewTargeting)
 {
 	bIsTargeting = bNewTargeting;
 
-	if (TargetingSound)
-	{
-		UGameplayStatics::SpawnSoundAttached(TargetingSound, GetRootComponent());
-	}
-
-	if (GetLocalRole() < ROLE_Authority)
+	if (TargetingSound.Get())
 	{
-		ServerSetTargeting(bNewTargeting);
+		UGameplayStatics::SpawnSoundAttached(TargetingSound.Get(), GetRootComponent());
 	}
-}
-
-bool AShooterCharacter::ServerSetTargeting_Validate(bool bNewTargeting)
-{
-	return true;
-}
 
-void AShooterCharacter::ServerSetTargeting_Implementation(bool bNewTargeting)
-{
-	SetTargeting(bNewTargeting);
+	// server picks up the new state from the next saved move
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -806,21 +1057,13 @@ void AShooterCharacter::SetSprinting(bool bNewSprinting, bool bToggle = false)
 	if (bWantsToSprint && bIsCrouched) {
 		UnCrouch();
 	}
-
-	if (GetLocalRole() < ROLE_Authority)
-	{
-		ServerSetSprinting(bNewSprinting, bToggle);
-	}
-}
-
-bool AShooterCharacter::ServerSetSprinting_Validate(bool bNewRunning, bool bToggle)
-{
-	return true;
 }
 
-void AShooterCharacter::ServerSetSprinting_Implementation(bool bNewRunning, bool bToggle)
+void AShooterCharacter::SetMovementFlags(bool bNewWantsToSprint, bool bNewTargeting, bool bNewJumping)
 {
-	SetSprinting(bNewRunning, bToggle);
+	bWantsToSprint = bNewWantsToSprint;
+	bIsTargeting = bNewTargeting;
+	bIsJumping = bNewJumping;
 }
 
 void AShooterCharacter::UpdateRunSounds()
@@ -835,9 +1078,9 @@ void AShooterCharacter::UpdateRunSounds()
 		{
 			RunLoopAC->Play();
 		}
-		else if (RunLoopSound != nullptr)
+		else if (RunLoopSound.Get() != nullptr)
 		{
-			RunLoopAC = UGameplayStatics::SpawnSoundAttached(RunLoopSound, GetRootComponent());
+			RunLoopAC = UGameplayStatics::SpawnSoundAttached(RunLoopSound.Get(), GetRootComponent());
 			if (RunLoopAC != nullptr)
 			{
 				RunLoopAC->bAutoDestroy = false;
@@ -847,9 +1090,9 @@ void AShooterCharacter::UpdateRunSounds()
 	else if (bIsRunSoundPlaying && !bWantsRunSoundPlaying)
 	{
 		RunLoopAC->Stop();
-		if (RunStopSound != nullptr)
+		if (RunStopSound.Get() != nullptr)
 		{
-			UGameplayStatics::SpawnSoundAttached(RunStopSound, GetRootComponent());
+			UGameplayStatics::SpawnSoundAttached(RunStopSound.Get(), GetRootComponent());
 		}
 	}
 }
@@ -1088,7 +1331,8 @@ bool AShooterCharacter::IsSprinting() const
 		return false;
 	}
 
-	return (bWantsToSprint || bWantsToSprintToggled) 
+	// toggled sprint always sets bWantsToSprint too, so saved moves only need to carry that one
+	return bWantsToSprint
 		&& !GetVelocity().IsZero() 
 		&& (GetVelocity().GetSafeNormal2D() | GetActorForwardVector()) > -0.1;
 }
@@ -1123,11 +1367,11 @@ void AShooterCharacter::Tick(float DeltaSeconds)
 	if (GEngine->UseSound())
 	{
 		// low health sound
-		if (LowHealthSound)
+		if (LowHealthSound.Get())
 		{
 			if ((this->Health > 0 && this->Health < this->GetMaxHealth() * LowHealthPercentage) && (!LowHealthWarningPlayer || !LowHealthWarningPlayer->IsPlaying()))
 			{
-				LowHealthWarningPlayer = UGameplayStatics::SpawnSoundAttached(LowHealthSound, GetRootComponent(),
+				LowHealthWarningPlayer = UGameplayStatics::SpawnSoundAttached(LowHealthSound.Get(), GetRootComponent(),
 					NAME_None, FVector(ForceInit), EAttachLocation::KeepRelativeOffset, true);
 				if (LowHealthWarningPlayer)
 				{
@@ -1148,15 +1392,15 @@ void AShooterCharacter::Tick(float DeltaSeconds)
 
 		// todo ref
 		UpdateRunSounds();
-	}
 
-	const APlayerController* PC = Cast<APlayerController>(GetController());
-	const bool bLocallyControlled = (PC ? PC->IsLocalController() : false);
-	const uint32 UniqueID = GetUniqueID();
-	FAudioThread::RunCommandOnAudioThread([UniqueID, bLocallyControlled]()
-	{
-	    USoundNodeLocalPlayer::GetLocallyControlledActorCache().Add(UniqueID, bLocallyControlled);
-	});
+		const APlayerController* PC = Cast<APlayerController>(GetController());
+		const bool bLocallyControlled = (PC ? PC->IsLocalController() : false);
+		const uint32 UniqueID = GetUniqueID();
+		FAudioThread::RunCommandOnAudioThread([UniqueID, bLocallyControlled]()
+		{
+		    USoundNodeLocalPlayer::GetLocallyControlledActorCache().Add(UniqueID, bLocallyControlled);
+		});
+	}
 	
 	TArray<FVector> PointsToTest;
 	BuildPauseReplicationCheckPoints(PointsToTest);
@@ -1206,6 +1450,7 @@ void AShooterCharacter::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > &
 	// everyone except local owner: flag change is locally instigated
 	DOREPLIFETIME_CONDITION(AShooterCharacter, bIsTargeting, COND_SkipOwner);
 	DOREPLIFETIME_CONDITION(AShooterCharacter, bWantsToSprint, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(AShooterCharacter, bIsJumping, COND_SkipOwner);
 
 	DOREPLIFETIME_CONDITION(AShooterCharacter, LastTakeHitInfo, COND_Custom);
 
@@ -1248,6 +1493,20 @@ bool AShooterCharacter::IsReplicationPausedForConnection(const FNetViewer& Conne
 void AShooterCharacter::OnReplicationPausedChanged(bool bIsReplicationPaused)
 {
 	GetMesh()->SetHiddenInGame(bIsReplicationPaused, true);
+
+	// nothing to look at, skip animation evaluation entirely
+	// the budget allocator owns the mesh tick while registered, so leave it before touching the tick and rejoin after
+	bMeshPausedByReplication = bIsReplicationPaused;
+	if (bIsReplicationPaused)
+	{
+		UpdateAnimationBudget();
+		GetMesh()->SetComponentTickEnabled(false);
+	}
+	else
+	{
+		GetMesh()->SetComponentTickEnabled(true);
+		UpdateAnimationBudget();
+	}
 }
 
 AShooterWeapon* AShooterCharacter::GetWeapon() const
@@ -1296,6 +1555,11 @@ float AShooterCharacter::GetSprintingSpeedModifier() const
 	return SprintingSpeedModifier;
 }
 
+bool AShooterCharacter::WantsToSprint() const
+{
+	return bWantsToSprint;
+}
+
 bool AShooterCharacter::IsFiring() const
 {
 	return CurrentWeapon 
@@ -1333,14 +1597,6 @@ float AShooterCharacter::GetLowHealthPercentage() const
 	return LowHealthPercentage;
 }
 
-void AShooterCharacter::UpdateTeamColorsAllMIDs()
-{
-	for (int32 i = 0; i < MeshMIDs.Num(); ++i)
-	{
-		UpdateTeamColors(MeshMIDs[i]);
-	}
-}
-
 void AShooterCharacter::InitView()
 {
 	APlayerController* PC = Cast<APlayerController>(GetController());
@@ -1360,7 +1616,7 @@ void AShooterCharacter::StartFire()
 	if (IsLocallyControlled()
 		&& CurrentWeapon && CurrentWeapon->GetCurrentAmmo() == 0)
 	{
-		UGameplayStatics::SpawnSoundAttached(CurrentWeapon->OutOfAmmoSound,
+		UGameplayStatics::SpawnSoundAttached(CurrentWeapon->OutOfAmmoSound.Get(),
 			GetRootComponent());
 
 		AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
@@ -1500,11 +1756,11 @@ void AShooterCharacter::SetIsJumping(bool NewJumping)
 			Jump();
 		}
 	}
+}
 
-	if (!HasAuthority())
-	{
-		ServerSetIsJumping(NewJumping);
-	}
+bool AShooterCharacter::IsJumping() const
+{
+	return bIsJumping;
 }
 
 
@@ -1520,14 +1776,4 @@ void AShooterCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode, ui
 	}
 }
 
-
-void AShooterCharacter::ServerSetIsJumping_Implementation(bool NewJumping)
-{
-	SetIsJumping(NewJumping);
-}
-
-bool AShooterCharacter::ServerSetIsJumping_Validate(bool NewJumping)
-{
-	return true;
-}
 #pragma endregion
@@ -3,6 +3,14 @@
 #include "ShooterGame.h"
 #include "Player/ShooterCharacterMovement.h"
 
+/** compressed flags used for shooter movement intent */
+namespace ShooterMoveFlags
+{
+	const uint8 Sprint = FSavedMove_Character::FLAG_Custom_0;
+	const uint8 Targeting = FSavedMove_Character::FLAG_Custom_1;
+	const uint8 Jumping = FSavedMove_Character::FLAG_Custom_2;
+}
+
 //----------------------------------------------------------------------//
 // UPawnMovementComponent
 //----------------------------------------------------------------------//
@@ -31,3 +39,131 @@ float UShooterCharacterMovement::GetMaxSpeed() const
 
 	return MaxSpeed;
 }
+
+void UShooterCharacterMovement::UpdateFromCompressedFlags(uint8 Flags)
+{
+	Super::UpdateFromCompressedFlags(Flags);
+
+	AShooterCharacter* ShooterCharacterOwner = Cast<AShooterCharacter>(PawnOwner);
+	if (ShooterCharacterOwner)
+	{
+		ShooterCharacterOwner->SetMovementFlags(
+			(Flags & ShooterMoveFlags::Sprint) != 0,
+			(Flags & ShooterMoveFlags::Targeting) != 0,
+			(Flags & ShooterMoveFlags::Jumping) != 0);
+	}
+}
+
+bool UShooterCharacterMovement::ClientUpdatePositionAfterServerUpdate()
+{
+	AShooterCharacter* ShooterCharacterOwner = Cast<AShooterCharacter>(PawnOwner);
+	if (ShooterCharacterOwner == nullptr)
+	{
+		return Super::ClientUpdatePositionAfterServerUpdate();
+	}
+
+	// saved moves overwrite intent while replaying
+	const bool bRealWantsToSprint = ShooterCharacterOwner->WantsToSprint();
+	const bool bRealIsTargeting = ShooterCharacterOwner->IsTargeting();
+	const bool bRealIsJumping = ShooterCharacterOwner->IsJumping();
+
+	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
+
+	ShooterCharacterOwner->SetMovementFlags(bRealWantsToSprint, bRealIsTargeting, bRealIsJumping);
+
+	return bResult;
+}
+
+FNetworkPredictionData_Client* UShooterCharacterMovement::GetPredictionData_Client() const
+{
+	if (ClientPredictionData == nullptr)
+	{
+		UShooterCharacterMovement* MutableThis = const_cast<UShooterCharacterMovement*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_Shooter(*this);
+	}
+
+	return ClientPredictionData;
+}
+
+//----------------------------------------------------------------------//
+// FSavedMove_Shooter
+//----------------------------------------------------------------------//
+void FSavedMove_Shooter::Clear()
+{
+	Super::Clear();
+
+	bSavedWantsToSprint = false;
+	bSavedIsTargeting = false;
+	bSavedIsJumping = false;
+}
+
+uint8 FSavedMove_Shooter::GetCompressedFlags() const
+{
+	uint8 Result = Super::GetCompressedFlags();
+
+	if (bSavedWantsToSprint)
+	{
+		Result |= ShooterMoveFlags::Sprint;
+	}
+	if (bSavedIsTargeting)
+	{
+		Result |= ShooterMoveFlags::Targeting;
+	}
+	if (bSavedIsJumping)
+	{
+		Result |= ShooterMoveFlags::Jumping;
+	}
+
+	return Result;
+}
+
+bool FSavedMove_Shooter::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	const FSavedMove_Shooter* NewShooterMove = static_cast<const FSavedMove_Shooter*>(NewMove.Get());
+	if (bSavedWantsToSprint != NewShooterMove->bSavedWantsToSprint
+		|| bSavedIsTargeting != NewShooterMove->bSavedIsTargeting
+		|| bSavedIsJumping != NewShooterMove->bSavedIsJumping)
+	{
+		return false;
+	}
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FSavedMove_Shooter::SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(Character, InDeltaTime, NewAccel, ClientData);
+
+	const AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(Character);
+	if (ShooterCharacter)
+	{
+		bSavedWantsToSprint = ShooterCharacter->WantsToSprint();
+		bSavedIsTargeting = ShooterCharacter->IsTargeting();
+		bSavedIsJumping = ShooterCharacter->IsJumping();
+	}
+}
+
+void FSavedMove_Shooter::PrepMoveFor(ACharacter* Character)
+{
+	Super::PrepMoveFor(Character);
+
+	// replaying after a correction: restore intent the move was made with
+	AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(Character);
+	if (ShooterCharacter)
+	{
+		ShooterCharacter->SetMovementFlags(bSavedWantsToSprint, bSavedIsTargeting, bSavedIsJumping);
+	}
+}
+
+//----------------------------------------------------------------------//
+// FNetworkPredictionData_Client_Shooter
+//----------------------------------------------------------------------//
+FNetworkPredictionData_Client_Shooter::FNetworkPredictionData_Client_Shooter(const UCharacterMovementComponent& ClientMovement)
+	: Super(ClientMovement)
+{
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_Shooter::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_Shooter());
+}
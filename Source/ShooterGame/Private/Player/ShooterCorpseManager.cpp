@@ -0,0 +1,239 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterCorpseManager.h"
+
+static int32 MaxSimulatingRagdolls = 6;
+FAutoConsoleVariableRef CVarMaxSimulatingRagdolls(
+	TEXT("p.MaxSimulatingRagdolls"),
+	MaxSimulatingRagdolls,
+	TEXT("Max number of corpses simulating physics at once, oldest are frozen first"),
+	ECVF_Default);
+
+static int32 MaxCorpses = 16;
+FAutoConsoleVariableRef CVarMaxCorpses(
+	TEXT("p.MaxCorpses"),
+	MaxCorpses,
+	TEXT("Max number of corpses in the world, oldest / farthest are recycled first"),
+	ECVF_Default);
+
+static float CorpseRestVelocity = 5.0f;
+FAutoConsoleVariableRef CVarCorpseRestVelocity(
+	TEXT("p.CorpseRestVelocity"),
+	CorpseRestVelocity,
+	TEXT("Root body speed (units/s) below which a ragdoll is considered at rest"),
+	ECVF_Default);
+
+static float CorpseRestTime = 0.5f;
+FAutoConsoleVariableRef CVarCorpseRestTime(
+	TEXT("p.CorpseRestTime"),
+	CorpseRestTime,
+	TEXT("Time (s) a ragdoll has to stay at rest before it is frozen"),
+	ECVF_Default);
+
+static float CorpseRecycleDistanceScale = 0.5f;
+FAutoConsoleVariableRef CVarCorpseRecycleDistanceScale(
+	TEXT("p.CorpseRecycleDistanceScale"),
+	CorpseRecycleDistanceScale,
+	TEXT("Seconds of corpse age one meter of distance from the closest local view is worth when picking corpses to recycle"),
+	ECVF_Default);
+
+/** how often settled bodies are checked */
+static const float CorpseUpdateInterval = 0.25f;
+
+void UShooterCorpseManager::Deinitialize()
+{
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_UpdateCorpses);
+	}
+
+	Corpses.Reset();
+
+	Super::Deinitialize();
+}
+
+void UShooterCorpseManager::RegisterCorpse(AShooterCharacter* Corpse)
+{
+	if (Corpse == NULL || Corpses.ContainsByPredicate([Corpse](const FCorpseInfo& Info) { return Info.Character == Corpse; }))
+	{
+		return;
+	}
+
+	FCorpseInfo NewInfo;
+	NewInfo.Character = Corpse;
+	NewInfo.StartTime = GetWorld()->GetTimeSeconds();
+	NewInfo.RestStartTime = 0.0f;
+	NewInfo.bFrozen = false;
+	Corpses.Add(NewInfo);
+
+	// multi kills: freeze / recycle right away instead of waiting for the next update
+	EnforceSimulationBudget();
+	EnforceCorpseBudget();
+
+	if (!GetWorld()->GetTimerManager().IsTimerActive(TimerHandle_UpdateCorpses))
+	{
+		GetWorld()->GetTimerManager().SetTimer(TimerHandle_UpdateCorpses, this, &UShooterCorpseManager::UpdateCorpses, CorpseUpdateInterval, true);
+	}
+}
+
+void UShooterCorpseManager::UnregisterCorpse(AShooterCharacter* Corpse)
+{
+	Corpses.RemoveAll([Corpse](const FCorpseInfo& Info) { return Info.Character == Corpse; });
+}
+
+int32 UShooterCorpseManager::GetNumSimulatingCorpses() const
+{
+	int32 NumSimulating = 0;
+	for (const FCorpseInfo& Info : Corpses)
+	{
+		if (!Info.bFrozen && Info.Character.IsValid())
+		{
+			NumSimulating++;
+		}
+	}
+
+	return NumSimulating;
+}
+
+void UShooterCorpseManager::UpdateCorpses()
+{
+	Corpses.RemoveAll([](const FCorpseInfo& Info) { return !Info.Character.IsValid() || Info.Character->IsPendingKill(); });
+
+	if (Corpses.Num() == 0)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_UpdateCorpses);
+		return;
+	}
+
+	const float TimeSeconds = GetWorld()->GetTimeSeconds();
+	for (FCorpseInfo& Info : Corpses)
+	{
+		if (Info.bFrozen)
+		{
+			continue;
+		}
+
+		USkeletalMeshComponent* Mesh = Info.Character->GetMesh();
+		const bool bAtRest = !Mesh->RigidBodyIsAwake()
+			|| Mesh->GetPhysicsLinearVelocity().SizeSquared() < FMath::Square(CorpseRestVelocity);
+
+		if (!bAtRest)
+		{
+			Info.RestStartTime = 0.0f;
+		}
+		else if (Info.RestStartTime <= 0.0f)
+		{
+			Info.RestStartTime = TimeSeconds;
+		}
+		else if (TimeSeconds - Info.RestStartTime >= CorpseRestTime)
+		{
+			FreezeCorpse(Info);
+		}
+	}
+
+	EnforceSimulationBudget();
+	EnforceCorpseBudget();
+}
+
+void UShooterCorpseManager::EnforceSimulationBudget()
+{
+	int32 NumToFreeze = GetNumSimulatingCorpses() - FMath::Max(MaxSimulatingRagdolls, 0);
+
+	// list is in registration order, so the oldest ragdolls give up simulation first
+	for (int32 i = 0; i < Corpses.Num() && NumToFreeze > 0; i++)
+	{
+		if (!Corpses[i].bFrozen && Corpses[i].Character.IsValid())
+		{
+			FreezeCorpse(Corpses[i]);
+			NumToFreeze--;
+		}
+	}
+}
+
+void UShooterCorpseManager::EnforceCorpseBudget()
+{
+	const int32 CorpseLimit = FMath::Max(MaxCorpses, 1);
+	if (Corpses.Num() <= CorpseLimit)
+	{
+		return;
+	}
+
+	TArray<FVector> ViewLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+
+	while (Corpses.Num() > CorpseLimit)
+	{
+		int32 RecycleIdx = 0;
+		float BestScore = -MAX_FLT;
+		for (int32 i = 0; i < Corpses.Num(); i++)
+		{
+			const float Score = GetRecycleScore(Corpses[i], ViewLocations);
+			if (Score > BestScore)
+			{
+				BestScore = Score;
+				RecycleIdx = i;
+			}
+		}
+
+		AShooterCharacter* Corpse = Corpses[RecycleIdx].Character.Get();
+		Corpses.RemoveAt(RecycleIdx);
+
+		if (Corpse && !Corpse->IsPendingKill())
+		{
+			Corpse->Destroy();
+		}
+	}
+}
+
+void UShooterCorpseManager::FreezeCorpse(FCorpseInfo& Info)
+{
+	USkeletalMeshComponent* Mesh = Info.Character.IsValid() ? Info.Character->GetMesh() : NULL;
+	if (Mesh)
+	{
+		// keep the last simulated pose: bodies sleep and other pawns can't wake them up again
+		Mesh->PutAllRigidBodiesToSleep();
+		Mesh->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+		Mesh->SetCollisionResponseToChannel(ECC_PhysicsBody, ECR_Ignore);
+		Mesh->bNoSkeletonUpdate = true;
+		Mesh->SetComponentTickEnabled(false);
+	}
+
+	Info.bFrozen = true;
+}
+
+float UShooterCorpseManager::GetRecycleScore(const FCorpseInfo& Info, const TArray<FVector>& ViewLocations) const
+{
+	if (!Info.Character.IsValid())
+	{
+		return MAX_FLT;
+	}
+
+	const float Age = GetWorld()->GetTimeSeconds() - Info.StartTime;
+
+	// no local view (dedicated server): oldest goes first
+	float ClosestDistSq = 0.0f;
+	if (ViewLocations.Num() > 0)
+	{
+		const FVector CorpseLocation = Info.Character->GetMesh()->GetComponentLocation();
+		ClosestDistSq = MAX_FLT;
+		for (const FVector& ViewLocation : ViewLocations)
+		{
+			ClosestDistSq = FMath::Min(ClosestDistSq, FVector::DistSquared(ViewLocation, CorpseLocation));
+		}
+	}
+
+	// distance in meters
+	return Age + FMath::Sqrt(ClosestDistSq) * 0.01f * CorpseRecycleDistanceScale;
+}
@@ -0,0 +1,279 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterPawnRegistry.h"
+#include "Online/ShooterPlayerState.h"
+
+static float PawnRegistryCellSize = 2000.0f;
+FAutoConsoleVariableRef CVarPawnRegistryCellSize(
+	TEXT("p.PawnRegistryCellSize"),
+	PawnRegistryCellSize,
+	TEXT("Cell size of the pawn registry spatial hash"),
+	ECVF_Default);
+
+void UShooterPawnRegistry::Deinitialize()
+{
+	Characters.Reset();
+	CellHeads.Reset();
+	TeamCellHeads.Reset();
+	LastRefreshFrame = 0;
+
+	Super::Deinitialize();
+}
+
+void UShooterPawnRegistry::RegisterCharacter(AShooterCharacter* Character)
+{
+	if (Character && !Characters.Contains(Character))
+	{
+		Characters.Add(Character);
+		LastRefreshFrame = 0;
+	}
+}
+
+void UShooterPawnRegistry::UnregisterCharacter(AShooterCharacter* Character)
+{
+	if (Characters.RemoveSingleSwap(Character) > 0)
+	{
+		LastRefreshFrame = 0;
+	}
+}
+
+int32 UShooterPawnRegistry::Num()
+{
+	ConditionalRefresh();
+	return Characters.Num();
+}
+
+void UShooterPawnRegistry::ConditionalRefresh()
+{
+	if (LastRefreshFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterPawnRegistry_Refresh);
+
+	LastRefreshFrame = GFrameCounter;
+	CellSize = FMath::Max(PawnRegistryCellSize, 100.0f);
+
+	const int32 NumCharacters = Characters.Num();
+	Locations.SetNumUninitialized(NumCharacters, false);
+	TeamNums.SetNumUninitialized(NumCharacters, false);
+	CapsuleRadii.SetNumUninitialized(NumCharacters, false);
+	CapsuleHalfHeights.SetNumUninitialized(NumCharacters, false);
+	NextInCell.SetNumUninitialized(NumCharacters, false);
+	NextInTeamCell.SetNumUninitialized(NumCharacters, false);
+	AliveFlags.Init(false, NumCharacters);
+	BotFlags.Init(false, NumCharacters);
+	CellHeads.Reset();
+	TeamCellHeads.Reset();
+	HashedTeams.Reset();
+	MaxCapsuleRadius = 0.0f;
+	MinCell = FIntPoint(MAX_int32, MAX_int32);
+	MaxCell = FIntPoint(MIN_int32, MIN_int32);
+
+	for (int32 i = 0; i < NumCharacters; i++)
+	{
+		AShooterCharacter* Character = Characters[i];
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		const AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(Character->GetPlayerState());
+
+		Locations[i] = Character->GetActorLocation();
+		TeamNums[i] = PlayerState ? PlayerState->GetTeamNum() : INDEX_NONE;
+		CapsuleRadii[i] = Capsule->GetScaledCapsuleRadius();
+		CapsuleHalfHeights[i] = Capsule->GetScaledCapsuleHalfHeight();
+		AliveFlags[i] = Character->IsAlive();
+		BotFlags[i] = Character->Controller != NULL && !Character->IsPlayerControlled();
+		MaxCapsuleRadius = FMath::Max(MaxCapsuleRadius, CapsuleRadii[i]);
+
+		const FIntPoint Cell = GetCell(Locations[i]);
+		int32& Head = CellHeads.FindOrAdd(Cell, INDEX_NONE);
+		NextInCell[i] = Head;
+		Head = i;
+
+		// living characters only, hostile queries never want corpses
+		NextInTeamCell[i] = INDEX_NONE;
+		if (AliveFlags[i])
+		{
+			int32& TeamHead = TeamCellHeads.FindOrAdd(FIntVector(Cell.X, Cell.Y, TeamNums[i]), INDEX_NONE);
+			NextInTeamCell[i] = TeamHead;
+			TeamHead = i;
+			HashedTeams.AddUnique(TeamNums[i]);
+		}
+
+		MinCell = FIntPoint(FMath::Min(MinCell.X, Cell.X), FMath::Min(MinCell.Y, Cell.Y));
+		MaxCell = FIntPoint(FMath::Max(MaxCell.X, Cell.X), FMath::Max(MaxCell.Y, Cell.Y));
+	}
+}
+
+FIntPoint UShooterPawnRegistry::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+template<typename Func>
+void UShooterPawnRegistry::ForEachCellInRing(const FIntPoint& Center, int32 Ring, Func&& VisitCell) const
+{
+	auto VisitClampedCell = [&](int32 X, int32 Y)
+	{
+		if (X >= MinCell.X && X <= MaxCell.X && Y >= MinCell.Y && Y <= MaxCell.Y)
+		{
+			VisitCell(X, Y);
+		}
+	};
+
+	if (Ring == 0)
+	{
+		VisitClampedCell(Center.X, Center.Y);
+		return;
+	}
+
+	// top and bottom rows, then the two side columns between them
+	for (int32 X = Center.X - Ring; X <= Center.X + Ring; X++)
+	{
+		VisitClampedCell(X, Center.Y - Ring);
+		VisitClampedCell(X, Center.Y + Ring);
+	}
+	for (int32 Y = Center.Y - Ring + 1; Y <= Center.Y + Ring - 1; Y++)
+	{
+		VisitClampedCell(Center.X - Ring, Y);
+		VisitClampedCell(Center.X + Ring, Y);
+	}
+}
+
+template<typename CellFunc>
+void UShooterPawnRegistry::FindKNearestInCells(const FVector& Origin, int32 K, float MaxRadius, FPawnFilter Filter, TArray<int32>& OutIndices, CellFunc&& ForEachInCell)
+{
+	ConditionalRefresh();
+	OutIndices.Reset();
+
+	if (K <= 0 || Characters.Num() == 0)
+	{
+		return;
+	}
+
+	const float MaxRadiusSq = FMath::Square(MaxRadius);
+	const FIntPoint Center = GetCell(Origin);
+	const int32 MaxRing = FMath::Max3(FMath::Abs(Center.X - MinCell.X), FMath::Abs(Center.X - MaxCell.X), FMath::Max(FMath::Abs(Center.Y - MinCell.Y), FMath::Abs(Center.Y - MaxCell.Y)));
+
+	TArray<TPair<float, int32>, TInlineAllocator<16>> Candidates;
+	for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		// everything not visited yet is at least this far away
+		const float RingDistSq = FMath::Square(FMath::Max(Ring - 1, 0) * CellSize);
+		if (RingDistSq > MaxRadiusSq)
+		{
+			break;
+		}
+		if (Candidates.Num() >= K && Candidates[K - 1].Key <= RingDistSq)
+		{
+			break;
+		}
+
+		ForEachCellInRing(Center, Ring, [&](int32 X, int32 Y)
+		{
+			ForEachInCell(X, Y, [&](int32 Idx)
+			{
+				const float DistSq = FVector::DistSquared(Locations[Idx], Origin);
+				if (DistSq <= MaxRadiusSq && Filter(Idx))
+				{
+					Candidates.Add(TPair<float, int32>(DistSq, Idx));
+				}
+			});
+		});
+
+		Candidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+	}
+
+	const int32 NumResults = FMath::Min(K, Candidates.Num());
+	OutIndices.Reserve(NumResults);
+	for (int32 i = 0; i < NumResults; i++)
+	{
+		OutIndices.Add(Candidates[i].Value);
+	}
+}
+
+int32 UShooterPawnRegistry::FindNearest(const FVector& Origin, float MaxRadius, FPawnFilter Filter)
+{
+	TArray<int32> Result;
+	FindKNearest(Origin, 1, MaxRadius, Filter, Result);
+
+	return Result.Num() > 0 ? Result[0] : INDEX_NONE;
+}
+
+void UShooterPawnRegistry::FindKNearest(const FVector& Origin, int32 K, float MaxRadius, FPawnFilter Filter, TArray<int32>& OutIndices)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterPawnRegistry_FindKNearest);
+
+	FindKNearestInCells(Origin, K, MaxRadius, Filter, OutIndices, [this](int32 X, int32 Y, auto&& Visit)
+	{
+		const int32* Head = CellHeads.Find(FIntPoint(X, Y));
+		for (int32 Idx = Head ? *Head : INDEX_NONE; Idx != INDEX_NONE; Idx = NextInCell[Idx])
+		{
+			Visit(Idx);
+		}
+	});
+}
+
+int32 UShooterPawnRegistry::FindNearestHostile(const FVector& Origin, int32 ExcludeTeamNum, float MaxRadius, FPawnFilter Filter)
+{
+	TArray<int32> Result;
+	FindKNearestHostile(Origin, ExcludeTeamNum, 1, MaxRadius, Filter, Result);
+
+	return Result.Num() > 0 ? Result[0] : INDEX_NONE;
+}
+
+void UShooterPawnRegistry::FindKNearestHostile(const FVector& Origin, int32 ExcludeTeamNum, int32 K, float MaxRadius, FPawnFilter Filter, TArray<int32>& OutIndices)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterPawnRegistry_FindKNearestHostile);
+
+	// only the cells of other teams are walked, team mates and corpses are never looked at
+	FindKNearestInCells(Origin, K, MaxRadius, Filter, OutIndices, [this, ExcludeTeamNum](int32 X, int32 Y, auto&& Visit)
+	{
+		for (int32 TeamNum : HashedTeams)
+		{
+			if (TeamNum == ExcludeTeamNum && ExcludeTeamNum != INDEX_NONE)
+			{
+				continue;
+			}
+
+			const int32* Head = TeamCellHeads.Find(FIntVector(X, Y, TeamNum));
+			for (int32 Idx = Head ? *Head : INDEX_NONE; Idx != INDEX_NONE; Idx = NextInTeamCell[Idx])
+			{
+				Visit(Idx);
+			}
+		}
+	});
+}
+
+void UShooterPawnRegistry::FindInRadius(const FVector& Origin, float Radius, FPawnFilter Filter, TArray<int32>& OutIndices)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterPawnRegistry_FindInRadius);
+
+	ConditionalRefresh();
+	OutIndices.Reset();
+
+	if (Characters.Num() == 0)
+	{
+		return;
+	}
+
+	const float RadiusSq = FMath::Square(Radius);
+	const FIntPoint MinQueryCell = GetCell(Origin - FVector(Radius, Radius, 0.0f));
+	const FIntPoint MaxQueryCell = GetCell(Origin + FVector(Radius, Radius, 0.0f));
+
+	for (int32 Y = FMath::Max(MinQueryCell.Y, MinCell.Y); Y <= FMath::Min(MaxQueryCell.Y, MaxCell.Y); Y++)
+	{
+		for (int32 X = FMath::Max(MinQueryCell.X, MinCell.X); X <= FMath::Min(MaxQueryCell.X, MaxCell.X); X++)
+		{
+			const int32* Head = CellHeads.Find(FIntPoint(X, Y));
+			for (int32 Idx = Head ? *Head : INDEX_NONE; Idx != INDEX_NONE; Idx = NextInCell[Idx])
+			{
+				if (FVector::DistSquared2D(Locations[Idx], Origin) <= RadiusSq && Filter(Idx))
+				{
+					OutIndices.Add(Idx);
+				}
+			}
+		}
+	}
+}
@@ -353,6 +353,13 @@ void AShooterPlayerController::PawnPendingDestroy(APawn* P)
 
 void AShooterPlayerController::GameHasEnded(class AActor* EndGameFocus, bool bIsWinner)
 {
+	// sent on this channel ahead of ClientGameEnded, so UpdateSaveFileOnGameEnd sees the final counts
+	AShooterPlayerState* ShooterPlayerState = Cast<AShooterPlayerState>(PlayerState);
+	if (ShooterPlayerState)
+	{
+		ClientSetShotStats(ShooterPlayerState->GetNumBulletsFired(), ShooterPlayerState->GetNumRocketsFired());
+	}
+
 	Super::GameHasEnded(EndGameFocus, bIsWinner);
 }
 
@@ -818,6 +825,27 @@ void AShooterPlayerController::CleanupSessionOnReturnToMenu()
 	}
 }
 
+void AShooterPlayerController::ClientReset_Implementation()
+{
+	Super::ClientReset_Implementation();
+
+	AShooterHUD* ShooterHUD = GetShooterHUD();
+	if (ShooterHUD)
+	{
+		ShooterHUD->SetMatchState(EShooterMatchState::Warmup);
+		ShooterHUD->ShowScoreboard(false);
+	}
+}
+
+void AShooterPlayerController::ClientSetShotStats_Implementation(int32 NumBulletsFired, int32 NumRocketsFired)
+{
+	AShooterPlayerState* ShooterPlayerState = Cast<AShooterPlayerState>(PlayerState);
+	if (ShooterPlayerState)
+	{
+		ShooterPlayerState->SetShotStats(NumBulletsFired, NumRocketsFired);
+	}
+}
+
 void AShooterPlayerController::ClientGameEnded_Implementation(class AActor* EndGameFocus, bool bIsWinner)
 {
 	Super::ClientGameEnded_Implementation(EndGameFocus, bIsWinner);
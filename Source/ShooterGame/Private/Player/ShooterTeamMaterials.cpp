@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterTeamMaterials.h"
+
+void UShooterTeamMaterials::Deinitialize()
+{
+	TeamMaterials.Reset();
+	TeamMaterialMap.Reset();
+
+	Super::Deinitialize();
+}
+
+void UShooterTeamMaterials::ApplyTeamColor(UMeshComponent* Mesh, int32 TeamNum)
+{
+	if (Mesh == NULL)
+	{
+		return;
+	}
+
+	for (int32 iMat = 0; iMat < Mesh->GetNumMaterials(); iMat++)
+	{
+		UMaterialInstanceDynamic* TeamMaterial = GetTeamMaterial(Mesh->GetMaterial(iMat), TeamNum);
+		if (TeamMaterial && TeamMaterial != Mesh->GetMaterial(iMat))
+		{
+			Mesh->SetMaterial(iMat, TeamMaterial);
+		}
+	}
+}
+
+UMaterialInstanceDynamic* UShooterTeamMaterials::GetTeamMaterial(UMaterialInterface* Material, int32 TeamNum)
+{
+	// team change: start again from the source material
+	UMaterialInstanceDynamic* MID = Cast<UMaterialInstanceDynamic>(Material);
+	if (MID && MID->Parent && TeamMaterials.Contains(MID))
+	{
+		Material = MID->Parent;
+	}
+
+	if (Material == NULL)
+	{
+		return NULL;
+	}
+
+	const TPair<const UMaterialInterface*, int32> Key(Material, TeamNum);
+	UMaterialInstanceDynamic* TeamMaterial = TeamMaterialMap.FindRef(Key);
+	if (TeamMaterial == NULL)
+	{
+		TeamMaterial = UMaterialInstanceDynamic::Create(Material, this);
+		TeamMaterial->SetScalarParameterValue(TEXT("Team Color Index"), (float)TeamNum);
+
+		TeamMaterials.Add(TeamMaterial);
+		TeamMaterialMap.Add(Key, TeamMaterial);
+	}
+
+	return TeamMaterial;
+}
@@ -3,15 +3,30 @@
 #include "ShooterGame.h"
 #include "ShooterTypes.h"
 #include "ShooterCharacter.h"
+#include "Weapons/ShooterDamageTypeRegistry.h"
+#include "Engine/NetSerialization.h"
+
+namespace TakeHitInfoNet
+{
+	/** kind of damage event, sent in 2 bits */
+	enum EEventKind
+	{
+		General,
+		Point,
+		Radial,
+	};
+}
 
 FTakeHitInfo::FTakeHitInfo()
 	: ActualDamage(0)
 	, DamageTypeClass(NULL)
 	, PawnInstigator(NULL)
 	, DamageCauser(NULL)
+	, VictimLocation(FVector::ZeroVector)
 	, DamageEventClassID(0)
 	, bKilled(false)
 	, EnsureReplicationByte(0)
+	, DamageTypeIndex(0)
 {}
 
 FDamageEvent& FTakeHitInfo::GetDamageEvent()
@@ -62,4 +77,135 @@ void FTakeHitInfo::SetDamageEvent(const FDamageEvent& DamageEvent)
 void FTakeHitInfo::EnsureReplication()
 {
 	EnsureReplicationByte++;
-}
\ No newline at end of file
+}
+
+void FTakeHitInfo::UpdateDamageTypeIndex(const UObject* WorldContextObject)
+{
+	UShooterDamageTypeRegistry* Registry = UShooterDamageTypeRegistry::Get(WorldContextObject);
+	if (Registry)
+	{
+		DamageTypeIndex = Registry->GetIndex(DamageTypeClass);
+	}
+	else
+	{
+		DamageTypeIndex = (DamageTypeClass == NULL || DamageTypeClass == UDamageType::StaticClass()) ? 0 : UShooterDamageTypeRegistry::UnregisteredIndex;
+	}
+}
+
+void FTakeHitInfo::ResolveDamageTypeClass(const UObject* WorldContextObject)
+{
+	if (DamageTypeClass == NULL)
+	{
+		UShooterDamageTypeRegistry* Registry = UShooterDamageTypeRegistry::Get(WorldContextObject);
+		DamageTypeClass = Registry ? Registry->GetClass(DamageTypeIndex) : UDamageType::StaticClass();
+	}
+}
+
+bool FTakeHitInfo::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	// damage in whole points, packed: one byte for anything below 128
+	uint32 QuantizedDamage = 0;
+	uint8 EventKind = TakeHitInfoNet::General;
+	uint8 bKilledBit = 0;
+	uint8 DirectionByte = 0;
+	FVector RadialOrigin = FVector::ZeroVector;
+
+	if (Ar.IsSaving())
+	{
+		QuantizedDamage = ActualDamage > 0.0f ? FMath::Max(FMath::RoundToInt(ActualDamage), 1) : 0;
+		bKilledBit = bKilled ? 1 : 0;
+
+		FVector Direction = FVector::ZeroVector;
+		if (DamageEventClassID == FPointDamageEvent::ClassID)
+		{
+			EventKind = TakeHitInfoNet::Point;
+			Direction = PointDamageEvent.ShotDirection;
+		}
+		else if (DamageEventClassID == FRadialDamageEvent::ClassID)
+		{
+			EventKind = TakeHitInfoNet::Radial;
+			RadialOrigin = RadialDamageEvent.Origin;
+			Direction = (RadialDamageEvent.ComponentHits.Num() > 0 ? FVector(RadialDamageEvent.ComponentHits[0].ImpactPoint) : VictimLocation) - RadialOrigin;
+		}
+
+		// only the horizontal direction is used by hit indicators
+		DirectionByte = FRotator::CompressAxisToByte(Direction.Rotation().Yaw);
+	}
+
+	Ar.SerializeIntPacked(QuantizedDamage);
+	Ar << DamageTypeIndex;
+	Ar.SerializeBits(&EventKind, 2);
+	Ar.SerializeBits(&bKilledBit, 1);
+	Ar << EnsureReplicationByte;
+
+	UObject* Instigator = PawnInstigator.Get();
+	bOutSuccess &= Map->SerializeObject(Ar, AShooterCharacter::StaticClass(), Instigator);
+
+	UObject* UnregisteredDamageTypeClass = DamageTypeClass;
+	if (DamageTypeIndex == UShooterDamageTypeRegistry::UnregisteredIndex)
+	{
+		bOutSuccess &= Map->SerializeObject(Ar, UClass::StaticClass(), UnregisteredDamageTypeClass);
+	}
+
+	if (EventKind != TakeHitInfoNet::General)
+	{
+		Ar << DirectionByte;
+	}
+	if (EventKind == TakeHitInfoNet::Radial)
+	{
+		bOutSuccess &= SerializePackedVector<1, 24>(RadialOrigin, Ar);
+	}
+
+	if (Ar.IsLoading())
+	{
+		ActualDamage = QuantizedDamage;
+		PawnInstigator = Cast<AShooterCharacter>(Instigator);
+		DamageCauser = NULL;
+		bKilled = bKilledBit != 0;
+
+		// registered classes are looked up by the owner of the hit info through ResolveDamageTypeClass
+		DamageTypeClass = NULL;
+		if (DamageTypeIndex == UShooterDamageTypeRegistry::UnregisteredIndex)
+		{
+			DamageTypeClass = Cast<UClass>(UnregisteredDamageTypeClass);
+			DamageTypeIndex = 0;
+		}
+		else if (DamageTypeIndex == 0)
+		{
+			DamageTypeClass = UDamageType::StaticClass();
+		}
+
+		// rebuild just enough of the damage event for GetBestHitInfo, GetDamageEvent fills in the damage type
+		const FVector Direction = FRotator(0.0f, FRotator::DecompressAxisFromByte(DirectionByte), 0.0f).Vector();
+		switch (EventKind)
+		{
+		case TakeHitInfoNet::Point:
+			DamageEventClassID = FPointDamageEvent::ClassID;
+			PointDamageEvent = FPointDamageEvent(ActualDamage, FHitResult(), Direction, NULL);
+			break;
+
+		case TakeHitInfoNet::Radial:
+		{
+			DamageEventClassID = FRadialDamageEvent::ClassID;
+			RadialDamageEvent = FRadialDamageEvent();
+			RadialDamageEvent.Origin = RadialOrigin;
+			RadialDamageEvent.Params.BaseDamage = ActualDamage;
+
+			FHitResult ComponentHit;
+			ComponentHit.ImpactPoint = RadialOrigin + Direction;
+			ComponentHit.Location = ComponentHit.ImpactPoint;
+			RadialDamageEvent.ComponentHits.Add(ComponentHit);
+			break;
+		}
+
+		default:
+			DamageEventClassID = FDamageEvent::ClassID;
+			GeneralDamageEvent = FDamageEvent();
+			break;
+		}
+	}
+
+	return true;
+}
@@ -463,9 +463,7 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 					int32 NumTeams = 0;
 					for (int32 i=0; i < MyGameState->NumTeams; i++)
 					{
-						RankedPlayerMap PlayerStateMap;
-						MyGameState->GetRankedMap(i,PlayerStateMap);
-						if(PlayerStateMap.Num() > 0)
+						if (MyGameState->GetRankedPlayers(i).Num() > 0)
 						{
 							NumTeams++;
 						}
@@ -474,11 +472,9 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 				}
 				else // free for all
 				{
-					RankedPlayerMap PlayerStateMap;
-					MyGameState->GetRankedMap(0,PlayerStateMap);
-					const int32* MyRank = PlayerStateMap.FindKey(MyPlayerState);
-					int32 MyPos = MyRank ? *MyRank + 1 : 0;
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, PlayerStateMap.Num());
+					const TArray<TWeakObjectPtr<AShooterPlayerState>>& RankedPlayers = MyGameState->GetRankedPlayers(0);
+					const int32 MyPos = RankedPlayers.IndexOfByKey(MyPlayerState) + 1;
+					Text = FString::Printf(TEXT("%d/%d"), MyPos, RankedPlayers.Num());
 				}
 				Canvas->StrLen(BigFont, Text, SizeX, SizeY);
 				Canvas->DrawIcon(PlaceIcon,
@@ -27,6 +27,7 @@ void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 
 	ScoreboardStartTime = FPlatformTime::Seconds();
 	MatchState = InArgs._MatchState.Get();
+	LastRankingVersion = 0;
 
 	UpdatePlayerStateMaps();
 	
@@ -283,8 +284,17 @@ void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 		AShooterGameState* const GameState = PCOwner->GetWorld()->GetGameState<AShooterGameState>();
 		if (GameState)
 		{
-			bool bRequiresWidgetUpdate = false;
 			const int32 NumTeams = FMath::Max(GameState->NumTeams, 1);
+
+			// maps only need rebuilding when the ranking changed, rows read scores from the PlayerStates
+			if (PlayerStateMaps.Num() == NumTeams && LastRankingVersion == GameState->GetRankingVersion())
+			{
+				UpdateSelectedPlayer();
+				return;
+			}
+			LastRankingVersion = GameState->GetRankingVersion();
+
+			bool bRequiresWidgetUpdate = false;
 			LastTeamPlayerCount.Reset();
 			LastTeamPlayerCount.AddZeroed(PlayerStateMaps.Num());
 			for (int32 i = 0; i < PlayerStateMaps.Num(); i++)
@@ -219,12 +219,15 @@ protected:
 	/** the player currently selected in the scoreboard */
 	FTeamPlayer SelectedPlayer;
 
-	/** the Ranked PlayerState map...cleared every frame */
+	/** the Ranked PlayerState map...rebuilt when the game state ranking changes */
 	TArray<RankedPlayerMap> PlayerStateMaps;
 
 	/** player count in each team in the last tick */
 	TArray<int32> LastTeamPlayerCount;
 
+	/** ranking version of the game state PlayerStateMaps were built from */
+	uint32 LastRankingVersion;
+
 	/** holds talking player data */
 	TArray<TPair<TSharedRef<const FUniqueNetId>, bool>> PlayersTalkingThisFrame;
 
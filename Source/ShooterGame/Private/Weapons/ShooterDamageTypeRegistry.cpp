@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterDamageTypeRegistry.h"
+#include "Weapons/ShooterDamageType.h"
+
+uint8 UShooterDamageTypeRegistry::GetIndex(UClass* DamageTypeClass)
+{
+	if (DamageTypeClass == NULL || DamageTypeClass == UDamageType::StaticClass())
+	{
+		return 0;
+	}
+
+	const uint8* Index = Indices.Find(DamageTypeClass);
+	if (Index == NULL)
+	{
+		ConditionalResolve();
+		Index = Indices.Find(DamageTypeClass);
+	}
+
+	return Index ? *Index : UnregisteredIndex;
+}
+
+UClass* UShooterDamageTypeRegistry::GetClass(uint8 Index)
+{
+	if (Index == 0 || Index == UnregisteredIndex)
+	{
+		return UDamageType::StaticClass();
+	}
+
+	if (!Classes.IsValidIndex(Index - 1) || !Classes[Index - 1].IsValid())
+	{
+		ConditionalResolve();
+	}
+
+	UClass* DamageTypeClass = Classes.IsValidIndex(Index - 1) ? Classes[Index - 1].Get() : NULL;
+	return DamageTypeClass ? DamageTypeClass : UDamageType::StaticClass();
+}
+
+UShooterDamageTypeRegistry* UShooterDamageTypeRegistry::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : NULL;
+	return World ? World->GetSubsystem<UShooterDamageTypeRegistry>() : NULL;
+}
+
+void UShooterDamageTypeRegistry::ConditionalResolve()
+{
+	if (LastResolveFrame == GFrameCounter && Classes.Num() > 0)
+	{
+		return;
+	}
+	LastResolveFrame = GFrameCounter;
+
+	const TArray<FSoftClassPath>& DamageTypes = GetDefault<UShooterDamageType>()->ReplicatedDamageTypes;
+	Classes.SetNum(FMath::Min<int32>(DamageTypes.Num(), UnregisteredIndex - 1));
+
+	// failed and stale entries only, lookups of classes that simply aren't registered stay cheap
+	bool bChanged = Indices.Num() == 0;
+	for (int32 i = 0; i < Classes.Num(); i++)
+	{
+		if (!Classes[i].IsValid())
+		{
+			Classes[i] = DamageTypes[i].TryLoadClass<UDamageType>();
+			bChanged = true;
+		}
+	}
+
+	if (bChanged)
+	{
+		Indices.Reset();
+		for (int32 i = 0; i < Classes.Num(); i++)
+		{
+			if (Classes[i].IsValid() && !Indices.Contains(Classes[i]))
+			{
+				Indices.Add(Classes[i], (uint8)(i + 1));
+			}
+		}
+	}
+}
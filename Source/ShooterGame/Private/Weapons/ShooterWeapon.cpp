@@ -8,6 +8,7 @@
 #include "Online/ShooterPlayerState.h"
 #include "UI/ShooterHUD.h"
 #include "MatineeCameraShake.h"
+#include "Engine/AssetManager.h"
 
 AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -56,11 +57,51 @@ void AShooterWeapon::PostInitializeComponents()
 	}
 
 	DetachMeshFromPawn();
+
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		// first person mesh is never seen on server
+		Mesh1P->SetComponentTickEnabled(false);
+		Mesh1P->UnregisterComponent();
+	}
+	else
+	{
+		TArray<FSoftObjectPath> CosmeticAssets;
+		GetCosmeticAssets(CosmeticAssets);
+		if (CosmeticAssets.Num() > 0)
+		{
+			CosmeticAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(CosmeticAssets);
+		}
+	}
+}
+
+void AShooterWeapon::GetCosmeticAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	auto AddAsset = [&OutAssets](const FSoftObjectPath& Asset)
+	{
+		if (!Asset.IsNull())
+		{
+			OutAssets.AddUnique(Asset);
+		}
+	};
+
+	AddAsset(MuzzleFX.ToSoftObjectPath());
+	AddAsset(FireCameraShake.ToSoftObjectPath());
+	AddAsset(FireSound.ToSoftObjectPath());
+	AddAsset(ReloadSound.ToSoftObjectPath());
+	AddAsset(EquipSound.ToSoftObjectPath());
+	AddAsset(OutOfAmmoSound.ToSoftObjectPath());
 }
 
 void AShooterWeapon::Destroyed()
 {
 	Super::Destroyed();
+
+	if (CosmeticAssetsHandle.IsValid())
+	{
+		CosmeticAssetsHandle->ReleaseHandle();
+		CosmeticAssetsHandle.Reset();
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -80,7 +121,7 @@ void AShooterWeapon::OnEquip(const AShooterWeapon* LastWeapon)
 
 	if (MyPawn && MyPawn->IsLocallyControlled())
 	{
-		PlayWeaponSound(EquipSound);
+		PlayWeaponSound(EquipSound.Get());
 	}
 
 	AShooterCharacter::NotifyEquipWeapon.Broadcast(MyPawn, this);
@@ -216,7 +257,7 @@ void AShooterWeapon::StartReload(bool bFromReplication)
 
 		if (MyPawn && MyPawn->IsLocallyControlled())
 		{
-			PlayWeaponSound(ReloadSound);
+			PlayWeaponSound(ReloadSound.Get());
 		}
 	}
 }
@@ -647,7 +688,9 @@ void AShooterWeapon::SimulateWeaponFire()
 		return;
 	}
 
-	if (MuzzleFX)
+	// cosmetic assets are loaded async on clients, skip whatever isn't there yet
+	UParticleSystem* MuzzleFXAsset = MuzzleFX.Get();
+	if (MuzzleFXAsset)
 	{
 		USkeletalMeshComponent* UseWeaponMesh = GetWeaponMesh();
 		if (MuzzlePSC == NULL)
@@ -659,7 +702,7 @@ void AShooterWeapon::SimulateWeaponFire()
 				if (PlayerCon != NULL)
 				{
 					Mesh1P->GetSocketLocation(MuzzleAttachPoint);
-					MuzzlePSC = UGameplayStatics::SpawnEmitterAttached(MuzzleFX, Mesh1P, MuzzleAttachPoint);
+					MuzzlePSC = UGameplayStatics::SpawnEmitterAttached(MuzzleFXAsset, Mesh1P, MuzzleAttachPoint);
 					MuzzlePSC->bOwnerNoSee = false;
 					MuzzlePSC->bOnlyOwnerSee = true;
 
@@ -668,20 +711,21 @@ void AShooterWeapon::SimulateWeaponFire()
 			}
 			else
 			{
-				MuzzlePSC = UGameplayStatics::SpawnEmitterAttached(MuzzleFX, UseWeaponMesh, MuzzleAttachPoint);
+				MuzzlePSC = UGameplayStatics::SpawnEmitterAttached(MuzzleFXAsset, UseWeaponMesh, MuzzleAttachPoint);
 			}
 		}
 	}
 
 	PlayWeaponAnimation(FireAnim); // todo add asset
-	PlayWeaponSound(FireSound);
+	PlayWeaponSound(FireSound.Get());
 
 	AShooterPlayerController* PC = (MyPawn != NULL) ? Cast<AShooterPlayerController>(MyPawn->Controller) : NULL;
 	if (PC != NULL && PC->IsLocalController())
 	{
-		if (FireCameraShake != NULL)
+		UClass* FireCameraShakeClass = FireCameraShake.Get();
+		if (FireCameraShakeClass != NULL)
 		{
-			PC->ClientStartCameraShake(FireCameraShake, 1);
+			PC->ClientStartCameraShake(FireCameraShakeClass, 1);
 		}
 	}
 }
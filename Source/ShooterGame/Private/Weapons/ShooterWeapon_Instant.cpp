@@ -10,6 +10,20 @@ AShooterWeapon_Instant::AShooterWeapon_Instant(const FObjectInitializer& ObjectI
 	CurrentFiringSpread = 0.0f;
 }
 
+void AShooterWeapon_Instant::GetCosmeticAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	Super::GetCosmeticAssets(OutAssets);
+
+	if (!ImpactTemplate.IsNull())
+	{
+		OutAssets.AddUnique(ImpactTemplate.ToSoftObjectPath());
+	}
+	if (!TrailFX.IsNull())
+	{
+		OutAssets.AddUnique(TrailFX.ToSoftObjectPath());
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Weapon usage
 
@@ -259,7 +273,8 @@ void AShooterWeapon_Instant::SimulateInstantHit(const FVector& ShotOrigin, int32
 
 void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact)
 {
-	if (ImpactTemplate && Impact.bBlockingHit)
+	UClass* ImpactTemplateClass = ImpactTemplate.Get();
+	if (ImpactTemplateClass && Impact.bBlockingHit)
 	{
 		FHitResult UseImpact = Impact;
 
@@ -273,7 +288,7 @@ void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact)
 		}
 
 		FTransform const SpawnTransform(Impact.ImpactNormal.Rotation(), Impact.ImpactPoint);
-		AShooterImpactEffect* EffectActor = GetWorld()->SpawnActorDeferred<AShooterImpactEffect>(ImpactTemplate, SpawnTransform);
+		AShooterImpactEffect* EffectActor = GetWorld()->SpawnActorDeferred<AShooterImpactEffect>(ImpactTemplateClass, SpawnTransform);
 		if (EffectActor)
 		{
 			EffectActor->SurfaceHit = UseImpact;
@@ -284,11 +299,12 @@ void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact)
 
 void AShooterWeapon_Instant::SpawnTrailEffect(const FVector& EndPoint)
 {
-	if (TrailFX)
+	UParticleSystem* TrailFXAsset = TrailFX.Get();
+	if (TrailFXAsset)
 	{
 		const FVector Origin = GetMuzzleLocation();
 
-		UParticleSystemComponent* TrailPSC = UGameplayStatics::SpawnEmitterAtLocation(this, TrailFX, Origin);
+		UParticleSystemComponent* TrailPSC = UGameplayStatics::SpawnEmitterAtLocation(this, TrailFXAsset, Origin);
 		if (TrailPSC)
 		{
 			TrailPSC->SetVectorParameter(TrailTargetParam, EndPoint);
@@ -4,20 +4,63 @@
 #include "BehaviorTree/BTDecorator.h"
 #include "BTDecorator_HasLoSTo.generated.h"
 
+struct FBTHasLoSToMemory
+{
+	/** last evaluated result */
+	bool bHasLOS;
+
+	/** bHasLOS is valid */
+	bool bHasResult;
+
+	/** blackboard key changed since last evaluation */
+	bool bDirty;
+
+	/** world time of last evaluation */
+	float Timestamp;
+
+	/** pending async trace for location targets */
+	FTraceHandle TraceHandle;
+
+	/** end points of pending trace */
+	FVector TraceStart;
+	FVector TraceEnd;
+};
 
 // Checks if the AI pawn has Line of sight to the specified Actor or Location(Vector).
+// Result is cached in node memory and refreshed asynchronously on key change or when older than MaxResultAge.
 UCLASS()
 class UBTDecorator_HasLoSTo : public UBTDecorator
 {
 	GENERATED_UCLASS_BODY()
 
 	virtual bool CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const override;
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual uint16 GetInstanceMemorySize() const override;
 
 protected:
 	
 	UPROPERTY(EditAnywhere, Category = Condition)
  	struct FBlackboardKeySelector EnemyKey;
 
+	/** cached result is refreshed when older than this (seconds) */
+	UPROPERTY(EditAnywhere, Category = Condition, meta = (ClampMin = "0.0"))
+	float MaxResultAge;
+
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+	/** blackboard observer for EnemyKey */
+	EBlackboardNotificationResult OnBlackboardKeyValueChange(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID);
+
 private:
-	bool LOSTrace(AActor* InActor, AActor* InEnemyActor, const FVector& EndLocation) const;	
+	/** refresh cached result if dirty or stale, returns true if bHasLOS changed */
+	bool UpdateLOS(UBehaviorTreeComponent& OwnerComp, FBTHasLoSToMemory* MyMemory) const;
+
+	/** store result in memory and abort if it changed */
+	void OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp) const;
+
+	/** check trace outcome against target */
+	bool IsLOSHit(AController* MyController, bool bBlockingHit, AActor* HitActor, const FVector& ImpactPoint, AActor* InEnemyActor, const FVector& StartLocation, const FVector& EndLocation) const;
 };
@@ -11,4 +11,10 @@ class UBTTask_FindPickup : public UBTTask_BlackboardBase
 	GENERATED_UCLASS_BODY()
 		
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+protected:
+
+	/** pick among the closest pickups by cached navmesh path length instead of straight line distance */
+	UPROPERTY(EditAnywhere, Category = Pickup)
+	bool bUsePathCost;
 };
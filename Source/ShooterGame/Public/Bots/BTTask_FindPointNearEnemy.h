@@ -5,11 +5,53 @@
 #include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
 #include "BTTask_FindPointNearEnemy.generated.h"
 
+struct FBTFindPointNearEnemyMemory
+{
+	/** pending UShooterNavQueries request, 0 if none */
+	uint32 RequestId;
+};
+
 // Bot AI task that tries to find a location near the current enemy
+// The navmesh queries are batched with other bots: a reachable point is found first,
+// then a path to it is tested, task finishes when that result comes back.
 UCLASS()
 class UBTTask_FindPointNearEnemy : public UBTTask_BlackboardBase
 {
 	GENERATED_UCLASS_BODY()
 
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+
+protected:
+
+	/** number of directions around the enemy scored on the influence map, direction towards the bot included */
+	UPROPERTY(EditAnywhere, Category = Positioning, meta = (ClampMin = "1"))
+	int32 NumCandidateDirections;
+
+	/** score penalty per hostile character around a candidate point */
+	UPROPERTY(EditAnywhere, Category = Positioning)
+	float ThreatWeight;
+
+	/** score penalty per recent death around a candidate point */
+	UPROPERTY(EditAnywhere, Category = Positioning)
+	float DeathHeatWeight;
+
+	/** score bonus per team mate around a candidate point */
+	UPROPERTY(EditAnywhere, Category = Positioning)
+	float FriendlyWeight;
+
+	/** points with a longer path from the bot are rejected, 0 only requires a complete path */
+	UPROPERTY(EditAnywhere, Category = Positioning, meta = (ClampMin = "0.0"))
+	float MaxPathLength;
+
+private:
+	/** reachable point query finished, test path from the bot */
+	void OnPointFound(uint32 RequestId, bool bSuccess, const FVector& Point, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
+
+	/** path test finished */
+	void OnPathFound(uint32 RequestId, bool bPathExists, float PathLength, FVector Point, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
+
+	/** fetch memory of pending request, NULL if it was aborted or superseded */
+	FBTFindPointNearEnemyMemory* GetPendingMemory(UBehaviorTreeComponent& OwnerComp, uint32 RequestId);
 };
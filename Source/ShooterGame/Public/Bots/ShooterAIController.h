@@ -2,9 +2,11 @@
 
 #pragma once
 #include "AIController.h"
+#include "Bots/ShooterBotLODManager.h"
 #include "ShooterAIController.generated.h"
 
 class UBehaviorTreeComponent;
+class UShooterBehaviorTreeComponent;
 class UBlackboardComponent;
 
 UCLASS(config=Game)
@@ -18,12 +20,14 @@ private:
 
 	/* Cached BT component */
 	UPROPERTY(transient)
-	UBehaviorTreeComponent* BehaviorComp;
+	UShooterBehaviorTreeComponent* BehaviorComp;
 public:
 
 	// Begin AController interface
 	virtual void GameHasEnded(class AActor* EndGameFocus = NULL, bool bIsWinner = false) override;
 	virtual void BeginInactiveState() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Reset() override;
 
 protected:
 	virtual void OnPossess(class APawn* InPawn) override;
@@ -52,6 +56,21 @@ public:
 		
 	bool HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy) const;
 
+	/** [server] switch update rates of behavior, perception and movement */
+	void SetLODLevel(EShooterBotLOD::Type NewLODLevel);
+
+	/** get current level of detail */
+	EShooterBotLOD::Type GetLODLevel() const { return LODLevel; }
+
+	/** [server] bind to crowd entity, marks this controller as owned by UShooterCrowdManager */
+	void SetCrowdEntityIndex(int32 NewIndex);
+
+	/** get crowd entity this bot represents, INDEX_NONE while pooled or for regular bots */
+	int32 GetCrowdEntityIndex() const { return CrowdEntityIndex; }
+
+	/** check if this controller is owned by UShooterCrowdManager */
+	bool IsCrowdBot() const { return bCrowdBot; }
+
 	// Begin AAIController interface
 	/** Update direction AI is looking based on FocalPoint */
 	virtual void UpdateControlRotation(float DeltaTime, bool bUpdatePawn = true) override;
@@ -64,12 +83,39 @@ protected:
 	int32 EnemyKeyID;
 	int32 NeedAmmoKeyID;
 
+	/** level of detail assigned by UShooterBotLODManager */
+	EShooterBotLOD::Type LODLevel;
+
+	/** apply tick intervals of current LOD to behavior and pawn */
+	void ApplyLODLevel();
+
+	/** think phase slot from UShooterBotThinkScheduler */
+	int32 ThinkPhase;
+
+	/** start behavior tree of possessed bot, deferred to our think phase */
+	void StartBehavior();
+
+	/** team skipped by hostile pawn registry queries, INDEX_NONE when everyone can be an enemy */
+	int32 GetHostileQueryExcludeTeam() const;
+
+	/** crowd entity this bot represents */
+	int32 CrowdEntityIndex;
+
+	/** spawned and respawned by UShooterCrowdManager instead of the game mode */
+	bool bCrowdBot;
+
 	/** Handle for efficient management of Respawn timer */
 	FTimerHandle TimerHandle_Respawn;
 
+	/** Handle for efficient management of StartBehavior timer */
+	FTimerHandle TimerHandle_StartBehavior;
+
+	/** Handle for efficient management of ApplyLODLevel timer */
+	FTimerHandle TimerHandle_ApplyLODLevel;
+
 public:
 	/** Returns BlackboardComp subobject **/
 	FORCEINLINE UBlackboardComponent* GetBlackboardComp() const { return BlackboardComp; }
 	/** Returns BehaviorComp subobject **/
-	FORCEINLINE UBehaviorTreeComponent* GetBehaviorComp() const { return BehaviorComp; }
+	FORCEINLINE UShooterBehaviorTreeComponent* GetBehaviorComp() const { return BehaviorComp; }
 };
@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "ShooterBehaviorTreeComponent.generated.h"
+
+/**
+ * Behavior tree component that can be held to a minimum time between updates.
+ * The tree reschedules its own tick interval from what its nodes need, so a plain component tick interval
+ * is overwritten on the next update; the throttle is applied on top of whatever the tree asks for.
+ */
+UCLASS()
+class UShooterBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UShooterBehaviorTreeComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	// Begin UActorComponent interface
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	// End UActorComponent interface
+
+	/** [server] set minimum time between tree updates and restart counting it, 0 lets the tree update as often as it wants */
+	void SetThrottleInterval(float NewThrottleInterval);
+
+	/** get minimum time between tree updates */
+	float GetThrottleInterval() const { return ThrottleInterval; }
+
+protected:
+
+	/** minimum time between tree updates */
+	float ThrottleInterval;
+
+	/** time passed since the tree was last updated */
+	float ThrottledDeltaTime;
+};
@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterBotLODManager.generated.h"
+
+class AShooterAIController;
+
+namespace EShooterBotLOD
+{
+	enum Type
+	{
+		/** full fidelity */
+		Near,
+		/** reduced behavior tree rate and older perception */
+		Medium,
+		/** also reduced movement rate */
+		Far,
+	};
+}
+
+/**
+ * Periodically assigns a level of detail to each bot based on distance to the closest human viewer.
+ * Bots far from every human get slower behavior tree, perception and movement updates.
+ */
+UCLASS()
+class UShooterBotLODManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/** [server] bot started controlling a pawn */
+	void RegisterBot(AShooterAIController* Bot);
+
+	/** [server] bot lost its pawn */
+	void UnregisterBot(AShooterAIController* Bot);
+
+	/** get minimum time between behavior tree updates for LOD, 0 means as often as the tree needs */
+	static float GetBehaviorTickInterval(EShooterBotLOD::Type LODLevel);
+
+	/** get movement tick interval for LOD, 0 means every frame */
+	static float GetMovementTickInterval(EShooterBotLOD::Type LODLevel);
+
+	/** get multiplier applied to max age of cached line of sight results for LOD */
+	static float GetPerceptionAgeScale(EShooterBotLOD::Type LODLevel);
+
+protected:
+
+	/** registered bots */
+	TArray<TWeakObjectPtr<AShooterAIController>> Bots;
+
+	/** Handle for efficient management of UpdateLODs timer */
+	FTimerHandle TimerHandle_UpdateLODs;
+
+	/** pick LOD for every bot from distance to human viewers */
+	void UpdateLODs();
+
+	/** get LOD for distance, with hysteresis around current level */
+	static EShooterBotLOD::Type GetLODForDistance(float DistSq, EShooterBotLOD::Type CurrentLOD);
+};
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterBotPerception.generated.h"
+
+/** Cached result of a bot line of sight trace */
+struct FBotLOSResult
+{
+	/** actor that blocked the trace, null for world geometry */
+	TWeakObjectPtr<AActor> HitActor;
+
+	/** world time when the trace finished */
+	float Timestamp = 0.0f;
+
+	/** trace was blocked by something */
+	bool bBlockingHit = false;
+};
+
+/**
+ * Gathers bot to target line of sight requests, dedupes them by pair and issues them as async
+ * weapon traces within a per frame budget. Callers read the last finished result for the pair.
+ */
+UCLASS()
+class UShooterBotPerception : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/**
+	* [server] get cached weapon trace from viewer's eyes to target, queues a refresh when stale.
+	*
+	* @param Viewer		Pawn looking.
+	* @param Target		Actor looked at.
+	* @param OutResult	Last finished trace for the pair.
+	* @param MaxAgeScale	Multiplier of p.BotLOSMaxAge, for bots that can live with older results.
+	* @return false if no trace finished for the pair yet.
+	*/
+	bool GetLOS(APawn* Viewer, AActor* Target, FBotLOSResult& OutResult, float MaxAgeScale = 1.0f);
+
+protected:
+
+	struct FLOSKey
+	{
+		TWeakObjectPtr<APawn> Viewer;
+		TWeakObjectPtr<AActor> Target;
+
+		bool operator==(const FLOSKey& Other) const
+		{
+			return Viewer == Other.Viewer && Target == Other.Target;
+		}
+
+		friend uint32 GetTypeHash(const FLOSKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Viewer), GetTypeHash(Key.Target));
+		}
+	};
+
+	struct FLOSEntry
+	{
+		FBotLOSResult Result;
+
+		/** world time of last GetLOS for the pair, idle pairs are evicted */
+		float LastRequestTime = 0.0f;
+
+		/** at least one trace finished */
+		bool bHasResult = false;
+
+		/** waiting in RequestQueue or for async trace */
+		bool bPending = false;
+	};
+
+	/** known pairs */
+	TMap<FLOSKey, FLOSEntry> Entries;
+
+	/** pairs waiting for a trace, oldest first */
+	TArray<FLOSKey> RequestQueue;
+
+	/** async traces in flight, by trace user data */
+	TMap<uint32, FLOSKey> InFlight;
+
+	/** user data for next trace */
+	uint32 NextTraceId = 0;
+
+	/** world time of last idle pair eviction */
+	float LastEvictTime = 0.0f;
+
+	/** flush is scheduled for next tick */
+	bool bFlushScheduled = false;
+
+	/** bound to OnTraceCompleted */
+	FTraceDelegate TraceDelegate;
+
+	/** issue queued traces up to budget, reschedules itself while queue is not empty */
+	void FlushRequests();
+
+	/** store async trace result */
+	void OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	/** drop pairs nobody asked about recently */
+	void EvictIdleEntries(float Now);
+};
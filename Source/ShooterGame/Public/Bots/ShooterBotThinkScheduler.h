@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterBotThinkScheduler.generated.h"
+
+/**
+ * Spreads bot thinking across frames.
+ * Each bot gets one of a fixed number of phase slots on a shared period, and starts its behavior tree and
+ * applies new tick intervals only at its slot, so services and decorators of bots restarted together don't stay aligned.
+ */
+UCLASS()
+class UShooterBotThinkScheduler : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** [server] take the least used phase slot, INDEX_NONE when staggering is disabled */
+	int32 AcquirePhase();
+
+	/** [server] give back a slot from AcquirePhase */
+	void ReleasePhase(int32 Phase);
+
+	/** get time until the next start of a phase slot, 0 when staggering is disabled */
+	float GetPhaseDelay(int32 Phase) const;
+
+protected:
+
+	/** number of bots holding each slot */
+	TArray<int32> PhaseLoad;
+
+	/** resize PhaseLoad to p.BotThinkPhases, keeping counts of slots already handed out */
+	void RemapPhaseLoad();
+};
@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterCrowdManager.generated.h"
+
+class AShooterAIController;
+
+/**
+ * Lightweight filler bots, enabled with the CrowdBots=<count> game option.
+ * Bots away from humans are plain data in structure of arrays form, run by a few processor passes on the server.
+ * Near a human viewer they are promoted to a full AShooterBot with its own controller and behavior tree,
+ * and demoted back to data once everybody is far away again.
+ */
+UCLASS()
+class UShooterCrowdManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/** [server] create crowd entities at spawn points and start simulating */
+	void SpawnCrowd(int32 NumEntities);
+
+	/** [server] promoted bot died, turn it back into a crowd entity */
+	void OnPromotedBotDied(AShooterAIController* Bot);
+
+	/** [server] demote every entity and respawn all of them for a new match */
+	void ResetCrowd();
+
+	/** get number of crowd entities */
+	int32 GetNumEntities() const { return Positions.Num(); }
+
+	/** get number of entities currently promoted to full bots */
+	int32 GetNumPromoted() const { return NumPromoted; }
+
+protected:
+
+	/** entity data, all same size */
+	TArray<FVector> Positions;
+	TArray<FVector> Goals;
+	TArray<int32> TeamNums;
+	TArray<float> Healths;
+	TArray<float> FireCooldowns;
+	TArray<float> RespawnTimes;
+	TArray<int32> Targets;
+
+	/** controller of promoted entities, null while simulated as data */
+	UPROPERTY(Transient)
+	TArray<AShooterAIController*> Controllers;
+
+	/** controllers of demoted entities without player state, reused on next promotion */
+	UPROPERTY(Transient)
+	TArray<AShooterAIController*> ControllerPool;
+
+	/** number of non null Controllers */
+	int32 NumPromoted = 0;
+
+	/** spatial hash of simulated entities: first entity per cell, linked through NextInCell */
+	TMap<FIntPoint, int32> CellHeads;
+	TArray<int32> NextInCell;
+
+	/** cell size used for the current hash */
+	float CellSize = 1.0f;
+
+	/** cached spawn locations */
+	TArray<FVector> SpawnLocations;
+
+	/** Handle for efficient management of UpdateCrowd timer */
+	FTimerHandle TimerHandle_UpdateCrowd;
+
+	/** run all processors */
+	void UpdateCrowd();
+
+	/** bring dead entities back at a spawn point */
+	void ProcessRespawns(float Now);
+
+	/** rebuild spatial hash of simulated entities */
+	void ProcessSpatialHash();
+
+	/** pick closest hostile entity in range */
+	void ProcessTargeting();
+
+	/** shoot at targets */
+	void ProcessFiring(float DeltaTime, float Now);
+
+	/** walk towards goals, pick new ones on arrival */
+	void ProcessMovement(float DeltaTime);
+
+	/** promote entities near humans, demote promoted bots far from them */
+	void ProcessLOD();
+
+	/** spawn a full bot for entity */
+	void PromoteEntity(int32 Index);
+
+	/** store bot state in entity and remove its pawn */
+	void DemoteEntity(int32 Index);
+
+	/** put controller back in the pool, its player state leaves the scoreboard and team counts */
+	void ReleaseController(AShooterAIController* Bot);
+
+	/** check if entity is alive and simulated as data */
+	bool IsSimulated(int32 Index) const { return Healths[Index] > 0.0f && Controllers[Index] == NULL; }
+
+	/** check if entities are hostile */
+	bool IsHostile(int32 IndexA, int32 IndexB) const;
+
+	/** get hash cell for location */
+	FIntPoint GetCell(const FVector& Location) const;
+};
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterInfluenceMap.generated.h"
+
+/**
+ * Coarse 2D grid over the navmesh holding decaying presence per team and recent death heat.
+ * Updated incrementally a few times per second from the pawn registry and kill events, sampled in O(1) by bots.
+ */
+UCLASS()
+class UShooterInfluenceMap : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/** [server] someone died at location */
+	void AddDeath(const FVector& Location);
+
+	/** [server] get presence of characters hostile to team around location, roughly number of characters, without Querier's own presence */
+	float GetThreat(const FVector& Location, int32 TeamNum, const AActor* Querier = NULL);
+
+	/** [server] get presence of team mates around location, roughly number of characters, without Querier's own presence */
+	float GetFriendlyPresence(const FVector& Location, int32 TeamNum, const AActor* Querier = NULL);
+
+	/** [server] get recent death heat around location, roughly number of recent deaths */
+	float GetDeathHeat(const FVector& Location);
+
+protected:
+
+	/** presence layer per team, then death layer, each NumCells.X * NumCells.Y */
+	TArray<float> Layers;
+
+	/** number of presence layers, 1 for free for all */
+	int32 NumTeamLayers = 0;
+
+	/** world XY of grid corner */
+	FVector2D GridOrigin;
+
+	/** grid size in cells */
+	FIntPoint NumCells;
+
+	/** cell size used for the current grid */
+	float CellSize = 1.0f;
+
+	/** Handle for efficient management of UpdateMap timer */
+	FTimerHandle TimerHandle_UpdateMap;
+
+	/** allocate grid over navigation bounds and start updating */
+	void ConditionalInitialize();
+
+	/** decay layers and splat current character positions */
+	void UpdateMap();
+
+	/** get cell index for location, clamped to grid */
+	int32 GetCellIndex(const FVector& Location) const;
+
+	/** get offset of layer in Layers */
+	int32 GetLayerOffset(int32 Layer) const { return Layer * NumCells.X * NumCells.Y; }
+
+	/** get presence layer for team */
+	int32 GetTeamLayer(int32 TeamNum) const { return FMath::Clamp(TeamNum, 0, NumTeamLayers - 1); }
+
+	/** get death layer */
+	int32 GetDeathLayer() const { return NumTeamLayers; }
+
+	/** add value to cell at location and half of it to its neighbors */
+	void Splat(int32 Layer, const FVector& Location, float Value);
+
+	/** get presence a character standing at its current location converges to in the cell of location */
+	float GetSelfPresence(const FVector& Location, const AActor* Querier) const;
+
+	/** multiply whole layer range by factor */
+	void DecayLayers(int32 FirstLayer, int32 NumLayers, float Factor);
+};
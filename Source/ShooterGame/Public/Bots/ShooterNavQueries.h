@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationSystemTypes.h"
+#include "ShooterNavQueries.generated.h"
+
+/** reachable point query finished: request id, success, point */
+DECLARE_DELEGATE_ThreeParams(FShooterNavPointQueryDelegate, uint32, bool, const FVector&);
+
+/** path query finished: request id, complete path exists, path length */
+DECLARE_DELEGATE_ThreeParams(FShooterNavPathQueryDelegate, uint32, bool, float);
+
+/**
+ * Batches navigation queries from all bots.
+ * Path queries go through the navigation system's async pathfinding (worker thread),
+ * reachable point queries are run on the game thread. Both are issued within a per frame budget,
+ * results are delivered on the game thread in a later frame.
+ */
+UCLASS()
+class UShooterNavQueries : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/**
+	* [server] queue search for a random navigable point reachable from Origin.
+	*
+	* @param Querier	Controller whose nav agent is used.
+	* @param Origin		Search center.
+	* @param Radius		Search radius.
+	* @param OnComplete	Called with the result.
+	* @return Request id, 0 if the request could not be queued.
+	*/
+	uint32 RequestReachablePoint(AController* Querier, const FVector& Origin, float Radius, const FShooterNavPointQueryDelegate& OnComplete);
+
+	/**
+	* [server] queue path test, reports existence and length of a complete path.
+	*
+	* @param Querier	Controller whose nav agent is used.
+	* @param Start		Path start.
+	* @param End		Path end.
+	* @param OnComplete	Called with the result.
+	* @return Request id, 0 if the request could not be queued.
+	*/
+	uint32 RequestPath(AController* Querier, const FVector& Start, const FVector& End, const FShooterNavPathQueryDelegate& OnComplete);
+
+	/** [server] drop request, its delegate will not be called */
+	void CancelRequest(uint32 RequestId);
+
+protected:
+
+	struct FPointRequest
+	{
+		uint32 RequestId;
+		TWeakObjectPtr<AController> Querier;
+		FVector Origin;
+		float Radius;
+		FShooterNavPointQueryDelegate OnComplete;
+	};
+
+	struct FPathRequest
+	{
+		uint32 RequestId;
+		TWeakObjectPtr<AController> Querier;
+		FVector Start;
+		FVector End;
+		FShooterNavPathQueryDelegate OnComplete;
+	};
+
+	/** reachable point requests waiting for budget, oldest first */
+	TArray<FPointRequest> PointQueue;
+
+	/** path requests waiting for budget, oldest first */
+	TArray<FPathRequest> PathQueue;
+
+	/** path requests handed to the navigation system, by its query id */
+	TMap<uint32, FPathRequest> PendingPaths;
+
+	/** id of next request */
+	uint32 NextRequestId = 1;
+
+	/** flush is scheduled for next tick */
+	bool bFlushScheduled = false;
+
+	/** make sure queues are flushed next tick */
+	void ScheduleFlush();
+
+	/** run / issue queued requests up to budget, reschedules itself while queues are not empty */
+	void FlushRequests();
+
+	/** async pathfinding finished */
+	void OnPathFound(uint32 NavQueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+};
@@ -4,6 +4,8 @@
 
 #include "OnlineIdentityInterface.h"
 #include "ShooterPlayerController.h"
+#include "Pickups/ShooterPickupIndex.h"
+#include "Online/ShooterSpawnIndex.h"
 #include "ShooterGameMode.generated.h"
 
 class AShooterAIController;
@@ -70,15 +72,21 @@ class AShooterGameMode : public AGameMode
 	/** new player joins */
 	virtual void HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer) override;
 
-	/** hides the onscreen hud and restarts the map */
+	/** hides the onscreen hud and restarts the map, or the match in place */
 	virtual void RestartGame() override;
 
+	/** [server] reset players, bots, pickups and game state in the loaded world and go back to warmup */
+	void ResetMatch();
+
 	/** Creates AIControllers for all bots */
 	void CreateBotControllers();
 
 	/** Create a bot */
 	AShooterAIController* CreateBot(int32 BotNum);	
 
+	/** [server] give a bot controller without player state a fresh one, used for pooled crowd bots */
+	void InitBotPlayerState(AShooterAIController* AIC, int32 BotNum);
+
 	virtual void PostInitProperties() override;
 
 protected:
@@ -94,6 +102,10 @@ protected:
 	UPROPERTY(config)
 	int32 TimeBetweenMatches;
 
+	/** restart matches without travelling, clients keep the loaded map */
+	UPROPERTY(config)
+	bool bResetMatchInPlace;
+
 	/** score for kill */
 	UPROPERTY(config)
 	int32 KillScore;
@@ -122,6 +134,9 @@ protected:
 
 	bool bAllowBots;		
 
+	/** number of lightweight crowd bots, from CrowdBots game option */
+	int32 NumCrowdBots;
+
 	/** spawning all bots for this game */
 	void StartBots();
 
@@ -159,4 +174,15 @@ public:
 	UPROPERTY()
 	TArray<AShooterPickup*> LevelPickups;
 
+	/** get index of LevelPickups for nearest available queries */
+	FShooterPickupIndex& GetPickupIndex() { return PickupIndex; }
+
+protected:
+
+	/** LevelPickups by type, with availability */
+	FShooterPickupIndex PickupIndex;
+
+	/** player starts of the level, by kind of player allowed to use them */
+	FShooterSpawnIndex SpawnIndex;
+
 };
@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include "ShooterTypes.h"
 #include "ShooterOnlineGameMatches.h"
+#include "Pickups/ShooterPickupManager.h"
 #include "ShooterGameState.generated.h"
 
 /** ranked PlayerState map, created from the GameState */
@@ -34,11 +36,41 @@ public:
 	/** gets ranked PlayerState map for specific team */
 	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;	
 
+	/** gets PlayerStates of specific team, highest score first */
+	const TArray<TWeakObjectPtr<AShooterPlayerState>>& GetRankedPlayers(int32 TeamIndex) const;
+
+	/** gets counter bumped whenever ranking or ranked scores change */
+	uint32 GetRankingVersion() const { return RankingVersion; }
+
+	/** [all] move player to its place in the ranking after a score or team change */
+	void UpdatePlayerRanking(AShooterPlayerState* PlayerState);
+
+	/** gets number of players in team, kept up to date with the ranking */
+	int32 GetNumTeamPlayers(int32 TeamIndex) const { return GetRankedPlayers(TeamIndex).Num(); }
+
+	/** gets accumulated score of team */
+	int32 GetTeamScore(int32 TeamIndex) const { return TeamScores.IsValidIndex(TeamIndex) ? TeamScores[TeamIndex] : 0; }
+
+	/** [server] add points to team score */
+	void AddTeamScore(int32 TeamIndex, int32 Points);
+
+	virtual void AddPlayerState(APlayerState* PlayerState) override;
+	virtual void RemovePlayerState(APlayerState* PlayerState) override;
+
 	void RequestFinishAndExitToMainMenu();
 
 	virtual void HandleMatchHasStarted() override;
 	virtual void HandleMatchHasEnded() override;
 
+	/** [server] clear scores and timers for a new match in the same world */
+	virtual void Reset() override;
+
+	/** get level pickup order, respawn queue and availability updates */
+	FShooterPickupManager& GetPickupManager() { return PickupManager; }
+
+	/** get replicated availability of level pickups */
+	FShooterPickupAvailability& GetPickupAvailability() { return PickupAvailability; }
+
 protected:
 	UPROPERTY(config)
 	FString ActivityId;
@@ -47,4 +79,23 @@ protected:
 	bool bEnableGameFeedback;
 
 	FShooterOnlineGameMatches GameMatches;
+
+	/** availability of all level pickups, replaces per pickup replication */
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_PickupAvailability)
+	FShooterPickupAvailability PickupAvailability;
+
+	/** level pickups in replicated order */
+	FShooterPickupManager PickupManager;
+
+	UFUNCTION()
+	void OnRep_PickupAvailability();
+
+	/** PlayerStates per team, kept sorted by score */
+	TArray<TArray<TWeakObjectPtr<AShooterPlayerState>>> RankedPlayers;
+
+	/** bumped whenever RankedPlayers changes */
+	uint32 RankingVersion;
+
+	/** remove player from every team ranking */
+	bool RemoveFromRanking(AShooterPlayerState* PlayerState);
 };
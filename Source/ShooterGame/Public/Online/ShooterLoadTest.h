@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterLoadTest.generated.h"
+
+/**
+ * Bot only load test for dedicated servers, enabled with -BotLoadTest=<bots>.
+ * Fills the match with bots, records frame timings and memory for -BotLoadTestDuration=<seconds> after the match starts,
+ * writes them to -BotLoadTestCsv=<file> (default Saved/Profiling/BotLoadTest-<time>.csv) and exits.
+ * Meant to run with -server -nullrhi -nosound so rendering, audio and cosmetic paths are off.
+ */
+UCLASS()
+class UShooterLoadTest : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** get number of bots to fill the match with */
+	int32 GetNumBots() const { return NumBots; }
+
+	/** get test duration in seconds */
+	float GetDuration() const { return Duration; }
+
+	/** [server] match started, begin recording */
+	void StartRecording();
+
+protected:
+
+	struct FFrameSample
+	{
+		/** time since recording started */
+		float Time;
+
+		/** full frame time */
+		float FrameMs;
+
+		/** game thread busy time */
+		float GameThreadMs;
+
+		/** world tick up to end of actor / timer / tickable updates */
+		float WorldTickMs;
+
+		/** rest of the frame after world tick, network replication included */
+		float PostTickMs;
+
+		/** used physical memory */
+		float UsedMemoryMB;
+
+		/** living characters */
+		int32 NumCharacters;
+	};
+
+	/** recorded frames */
+	TArray<FFrameSample> Samples;
+
+	int32 NumBots = 0;
+	float Duration = 0.0f;
+	FString CsvFilename;
+
+	/** recording in progress */
+	bool bRecording = false;
+
+	/** cycles at frame boundaries */
+	double RecordingStartTime = 0.0;
+	double WorldTickStartTime = 0.0;
+	double PostActorTickTime = 0.0;
+	double LastFrameEndTime = 0.0;
+
+	FDelegateHandle OnWorldTickStartHandle;
+	FDelegateHandle OnWorldPostActorTickHandle;
+	FDelegateHandle OnEndFrameHandle;
+
+	/** Handle for efficient management of FinishTest timer */
+	FTimerHandle TimerHandle_FinishTest;
+
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnEndFrame();
+
+	/** stop recording and unbind delegates */
+	void StopRecording();
+
+	/** write csv and exit */
+	void FinishTest();
+};
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterMatchLog.generated.h"
+
+namespace EShooterMatchEvent
+{
+	enum Type
+	{
+		MatchStart,
+		MatchEnd,
+		Spawn,
+		Kill,
+		Damage,
+		BulletsFired,
+		RocketsFired,
+		Pickup,
+	};
+}
+
+/** fixed size record written as is to match log files */
+struct FShooterMatchEventRecord
+{
+	/** world time */
+	float Time;
+
+	/** EShooterMatchEvent */
+	uint8 Type;
+	uint8 Padding[3];
+
+	/** player ids, INDEX_NONE if not set */
+	int32 InstigatorId;
+	int32 TargetId;
+
+	/** damage, rounds fired, etc. */
+	float Value;
+
+	/** where it happened */
+	float X;
+	float Y;
+	float Z;
+};
+
+/** header at the start of match log files */
+struct FShooterMatchLogHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	uint32 RecordSize;
+	uint32 Reserved;
+
+	static const uint32 ExpectedMagic = 0x474C4D53; // "SMLG"
+	static const uint32 CurrentVersion = 1;
+};
+
+/**
+ * Server side combat event recorder, cheap enough to stay on in shipping builds (p.MatchLogEnabled).
+ * Events are appended to a fixed size buffer on the game thread; full buffers and the rest at match end
+ * are written to Saved/MatchLogs/<map>-<time>.smlog on a worker thread.
+ * Convert logs with: -run=ShooterMatchLog -In=<file.smlog> [-Out=<file.csv>]
+ */
+UCLASS()
+class UShooterMatchLog : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	/** [server] start a new log file */
+	void BeginMatch();
+
+	/** [server] write everything recorded so far and close the log */
+	void EndMatch();
+
+	/** [server] append event, no-op outside of a match */
+	void Record(EShooterMatchEvent::Type Type, const APlayerState* Instigator, const APlayerState* Target, float Value, const FVector& Location);
+
+	/** helper for game code: get log of world, if recording */
+	static UShooterMatchLog* Get(const UObject* WorldContextObject);
+
+protected:
+
+	/** events not handed to the writer yet */
+	TArray<FShooterMatchEventRecord> Buffer;
+
+	/** file of current match */
+	FString Filename;
+
+	/** last write task, each write waits for the previous one so blocks stay in order */
+	TFuture<void> PendingWrite;
+
+	/** match in progress */
+	bool bRecording = false;
+
+	/** header still needs to be written */
+	bool bNeedsHeader = false;
+
+	/** hand buffer to a worker thread */
+	void Flush();
+};
@@ -0,0 +1,19 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "ShooterMatchLogCommandlet.generated.h"
+
+/**
+ * Converts match logs written by UShooterMatchLog.
+ * -run=ShooterMatchLog -In=<file.smlog> [-Out=<file.csv>] [-Columns]
+ * -Columns writes one raw little endian file per field next to Out instead of a csv, for columnar tools.
+ */
+UCLASS()
+class UShooterMatchLogCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+	virtual int32 Main(const FString& Params) override;
+};
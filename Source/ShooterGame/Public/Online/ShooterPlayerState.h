@@ -24,6 +24,12 @@ class AShooterPlayerState : public APlayerState
 	virtual void RegisterPlayerWithSession(bool bWasFromInvite) override;
 	virtual void UnregisterPlayerWithSession() override;
 
+	/** keep ranking up to date on clients */
+	virtual void OnRep_Score() override;
+
+	/** [server] don't lose pending stats of leaving players */
+	virtual void Destroyed() override;
+
 	// End APlayerState interface
 
 	/**
@@ -75,10 +81,16 @@ class AShooterPlayerState : public APlayerState
 	UFUNCTION()
 	void OnRep_TeamColor();
 
-	//We don't need stats about amount of ammo fired to be server authenticated, so just increment these with local functions
+	/** [server] count shots, kept on the server until the match ends */
 	void AddBulletsFired(int32 NumBullets);
 	void AddRocketsFired(int32 NumRockets);
 
+	/** [client] shot counts sent by the server at the end of the match */
+	void SetShotStats(int32 InNumBulletsFired, int32 InNumRocketsFired);
+
+	/** [server] push pending kills, deaths and score to the replicated fields */
+	void FlushStats();
+
 	/** Set whether the player is a quitter */
 	void SetQuitter(bool bInQuitter);
 
@@ -119,6 +131,21 @@ protected:
 	UPROPERTY(Replicated)
 	FString MatchId;
 
+	/** kills not yet flushed to NumKills */
+	int32 PendingKills;
+
+	/** deaths not yet flushed to NumDeaths */
+	int32 PendingDeaths;
+
+	/** points not yet flushed to Score */
+	int32 PendingScore;
+
+	/** Handle for efficient management of FlushStats timer */
+	FTimerHandle TimerHandle_FlushStats;
+
 	/** helper for scoring points */
 	void ScorePoints(int32 Points);
+
+	/** move to our place in the game state ranking */
+	void UpdateRanking();
 };
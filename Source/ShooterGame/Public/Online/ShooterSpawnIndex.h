@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+class APlayerStart;
+
+/**
+ * Server side index of level player starts, collected once per map.
+ * Keeps the starts each kind of player may use and scores them in one pass
+ * by distance to the closest enemy, capped at p.SpawnSafeDistance, and how recently they were used.
+ */
+class FShooterSpawnIndex
+{
+public:
+
+	FShooterSpawnIndex();
+
+	/** collect player starts of the world */
+	void Build(UWorld* World);
+
+	/** check if Build was called since the last Reset */
+	bool IsBuilt() const { return bBuilt; }
+
+	/** get "Play from Here" start, if any */
+	APlayerStart* GetPIEStart() const { return PIEStart.Get(); }
+
+	/**
+	* Get starts usable by a kind of player, filled on first use.
+	*
+	* @param Key			Identifies players with the same allowed starts, e.g. team and bot flag.
+	* @param IsAllowed		Called once per start when the list is filled.
+	* @return Start indices.
+	*/
+	const TArray<int32>& GetCandidates(const FIntPoint& Key, TFunctionRef<bool(APlayerStart*)> IsAllowed);
+
+	/**
+	* Pick best start among candidates. Starts that pass IsPreferred and weren't used this frame come first.
+	*
+	* @param Candidates		Start indices from GetCandidates.
+	* @param IsPreferred	Called for candidates, usually an overlap check.
+	* @param GetEnemyDist	Called for candidates with a location and max distance, returns distance to the closest living enemy of the spawning player or max distance if none is closer.
+	* @param Now			Current world time.
+	* @return Start index or INDEX_NONE.
+	*/
+	int32 ChooseBest(const TArray<int32>& Candidates, TFunctionRef<bool(APlayerStart*)> IsPreferred, TFunctionRef<float(const FVector&, float)> GetEnemyDist, float Now) const;
+
+	/** remember start was just used */
+	void MarkUsed(int32 Index, float Now);
+
+	/** forget when starts were used, for a match restarting in place */
+	void ResetUseTimes();
+
+	/** get start at index, can be null if it was destroyed */
+	APlayerStart* GetStart(int32 Index) const { return Starts[Index].Get(); }
+
+	/** forget all starts */
+	void Reset();
+
+private:
+
+	/** all starts, except PIEStart */
+	TArray<TWeakObjectPtr<APlayerStart>> Starts;
+
+	/** location of each start */
+	TArray<FVector> Locations;
+
+	/** last time each start was used */
+	TArray<float> LastUseTimes;
+
+	/** allowed start indices per kind of player */
+	TMap<FIntPoint, TArray<int32>> CandidateLists;
+
+	/** "Play from Here" start */
+	TWeakObjectPtr<APlayerStart> PIEStart;
+
+	/** starts were collected */
+	bool bBuilt;
+};
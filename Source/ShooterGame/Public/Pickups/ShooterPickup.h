@@ -16,10 +16,28 @@ class AShooterPickup : public AActor
 	/** check if pawn can use this pickup */
 	virtual bool CanBePickedUp(class AShooterCharacter* TestPawn) const;
 
+	/** get weapon class this pickup is for, if any */
+	virtual UClass* GetWeaponType() const;
+
+	/** check if pickup is ready for interactions */
+	bool IsActive() const { return bIsActive; }
+
+	/** [server] make pickup available again for a new match */
+	virtual void Reset() override;
+
+	/** [server] show and enable pickup, called by FShooterPickupManager when respawn time is up */
+	virtual void RespawnPickup();
+
+	/** [client] apply availability replicated through FShooterPickupManager */
+	void SetActiveFromReplication(bool bActive);
+
 protected:
 	/** initial setup */
 	virtual void BeginPlay() override;
 
+	/** leave the pickup manager and the bot pickup index */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
 	/** FX component */
 	UPROPERTY(VisibleDefaultsOnly, Category=Effects)
@@ -46,28 +64,22 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category=Pickup)
 	float RespawnTime;
 
-	/** is it ready for interactions? */
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_IsActive)
+	/** is it ready for interactions? replicated by the game state pickup bitfield */
+	UPROPERTY(Transient)
 	uint32 bIsActive:1;
 
-	/* The character who has picked up this pickup */
-	UPROPERTY(Transient, Replicated)
+	/* The character who has picked up this pickup, on clients only set for local players */
+	UPROPERTY(Transient)
 	AShooterCharacter* PickedUpBy;
 
-	/** Handle for efficient management of RespawnPickup timer */
-	FTimerHandle TimerHandle_RespawnPickup;
-
-	UFUNCTION()
-	void OnRep_IsActive();
-
 	/** give pickup */
 	virtual void GivePickupTo(class AShooterCharacter* Pawn);
 
 	/** handle touches */
 	void PickupOnTouch(class AShooterCharacter* Pawn);
 
-	/** show and enable pickup */
-	virtual void RespawnPickup();
+	/** [server] push availability to the game mode's pickup index and the game state bitfield */
+	void UpdateAvailability();
 
 	/** show effects when pickup disappears */
 	virtual void OnPickedUp();
@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+class AShooterPickup;
+class AShooterCharacter;
+
+/**
+ * Server side index of level pickups, bucketed by pickup class and weapon class.
+ * Availability is pushed by the pickups, so queries only look at active pickups of matching buckets,
+ * searched outwards through a coarse grid of each bucket.
+ * Pickups are kept alive by AShooterGameMode::LevelPickups.
+ */
+class FShooterPickupIndex
+{
+public:
+
+	/** add pickup to its bucket */
+	void AddPickup(AShooterPickup* Pickup);
+
+	/** remove pickup and its cached path costs */
+	void RemovePickup(AShooterPickup* Pickup);
+
+	/** pickup was taken or respawned */
+	void SetAvailable(AShooterPickup* Pickup, bool bAvailable);
+
+	/**
+	* Find closest active pickup the pawn can use.
+	*
+	* @param PickupType		Pickup class to look for.
+	* @param WeaponType		Weapon class the pickup has to be for, none to accept all.
+	* @param ForPawn		Pawn looking for a pickup.
+	* @param bUsePathCost	Pick by navmesh path length among the closest candidates instead of straight line distance.
+	* @return Pickup or NULL.
+	*/
+	AShooterPickup* FindNearestAvailable(UClass* PickupType, UClass* WeaponType, AShooterCharacter* ForPawn, bool bUsePathCost = false);
+
+	/** forget all pickups and cached path costs */
+	void Reset();
+
+private:
+
+	struct FBucket
+	{
+		/** exact class of pickups in this bucket */
+		UClass* PickupClass;
+
+		/** weapon class of pickups in this bucket, can be null */
+		UClass* WeaponClass;
+
+		/** all pickups of the bucket */
+		TArray<AShooterPickup*> Pickups;
+
+		/** active pickups of the bucket by grid cell */
+		TMap<FIntPoint, TArray<AShooterPickup*>> AvailableCells;
+
+		/** number of active pickups in AvailableCells */
+		int32 NumAvailable = 0;
+
+		/** bounds of cells holding pickups of the bucket */
+		FIntPoint MinCell;
+		FIntPoint MaxCell;
+	};
+
+	TArray<FBucket> Buckets;
+
+	/** bucket index of each pickup */
+	TMap<AShooterPickup*, int32> PickupBuckets;
+
+	/** path length to pickup from quantized start locations, negative if unreachable */
+	TMap<AShooterPickup*, TMap<FIntVector, float>> PathCosts;
+
+	/** get grid cell of location */
+	static FIntPoint GetCell(const FVector& Location);
+
+	/** get cached path length from start to pickup, negative if unreachable */
+	float GetPathCost(AShooterCharacter* ForPawn, AShooterPickup* Pickup);
+};
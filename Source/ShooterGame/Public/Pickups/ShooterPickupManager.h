@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+class AShooterPickup;
+class AShooterGameState;
+
+/**
+ * Keeps level pickups in the same order on server and clients, owned by AShooterGameState.
+ * Server: runs all pickup respawns from one queue and timer, and writes availability to the game state bitfield.
+ * Clients: apply the replicated bitfield to pickups, which stay dormant and never open an actor channel.
+ */
+class FShooterPickupManager
+{
+public:
+
+	FShooterPickupManager();
+
+	/** set game state owning the replicated bitfield */
+	void Initialize(AShooterGameState* InOwner);
+
+	/** [all] add level pickup, called from BeginPlay */
+	void RegisterPickup(AShooterPickup* Pickup);
+
+	/** [all] remove pickup leaving the world, called from EndPlay */
+	void UnregisterPickup(AShooterPickup* Pickup);
+
+	/** [server] pickup was taken or respawned */
+	void SetAvailable(AShooterPickup* Pickup, bool bAvailable);
+
+	/** [server] respawn pickup after delay */
+	void ScheduleRespawn(AShooterPickup* Pickup, float Delay);
+
+	/** [server] drop pending respawn of pickup */
+	void CancelRespawn(AShooterPickup* Pickup);
+
+	/** [client] push replicated bitfield to pickups */
+	void ApplyAvailability();
+
+private:
+
+	struct FPendingRespawn
+	{
+		float Time;
+		TWeakObjectPtr<AShooterPickup> Pickup;
+
+		bool operator<(const FPendingRespawn& Other) const { return Time < Other.Time; }
+	};
+
+	/** level pickups, sorted by path name so every machine agrees on indices */
+	TArray<AShooterPickup*> Pickups;
+
+	/** index of each pickup in Pickups */
+	TMap<AShooterPickup*, int32> PickupIndices;
+
+	/** pickups were added or removed since indices were last built */
+	bool bPickupsDirty;
+
+	/** min heap of pending respawns */
+	TArray<FPendingRespawn> RespawnQueue;
+
+	/** Handle for efficient management of ProcessRespawns timer */
+	FTimerHandle TimerHandle_ProcessRespawns;
+
+	AShooterGameState* Owner;
+
+	/** sort pickups, rebuild indices and availability once per batch of (un)registrations */
+	void RefreshPickups();
+
+	/** refresh next tick, pickups of a level all register in the same frame */
+	void ScheduleRefresh();
+
+	/** respawn due pickups and rearm the timer */
+	void ProcessRespawns();
+
+	/** set timer for the earliest pending respawn */
+	void UpdateRespawnTimer();
+};
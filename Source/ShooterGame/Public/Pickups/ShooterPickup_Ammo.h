@@ -19,6 +19,9 @@ class AShooterPickup_Ammo : public AShooterPickup
 
 	bool IsForWeapon(UClass* WeaponClass);
 
+	/** get weapon class this pickup is for */
+	virtual UClass* GetWeaponType() const override;
+
 protected:
 
 	/** how much ammo does it give? */
@@ -7,6 +7,7 @@
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnShooterCharacterEquipWeapon, AShooterCharacter*, AShooterWeapon* /* new */);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnShooterCharacterUnEquipWeapon, AShooterCharacter*, AShooterWeapon* /* old */);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnShooterCharacterInventoryWeapon, AShooterCharacter*, AShooterWeapon* /* weapon */);
 
 UCLASS(Abstract)
 class AShooterCharacter : public ACharacter
@@ -18,6 +19,12 @@ class AShooterCharacter : public ACharacter
 	/** spawn inventory, setup initial variables */
 	virtual void PostInitializeComponents() override;
 
+	/** register mesh with animation budget */
+	virtual void BeginPlay() override;
+
+	/** unregister mesh from animation budget */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Update the character. (Running, health etc). */
 	virtual void Tick(float DeltaSeconds) override;
 
@@ -105,15 +112,18 @@ class AShooterCharacter : public ACharacter
 	/** check if pawn can reload weapon */
 	bool CanReload() const;
 
-	/** [server + local] change targeting state */
+	/** [local] change targeting state */
 	void SetTargeting(bool bNewTargeting);
 
 	//////////////////////////////////////////////////////////////////////////
 	// Movement
 
-	/** [server + local] change running state */
+	/** [local] change running state */
 	void SetSprinting(bool bNewRunning, bool bToggle);
 
+	/** [server + local] apply sprint / targeting / jump intent carried by a saved move */
+	void SetMovementFlags(bool bNewWantsToSprint, bool bNewTargeting, bool bNewJumping);
+
 	//////////////////////////////////////////////////////////////////////////
 	// Animations
 
@@ -203,6 +213,18 @@ class AShooterCharacter : public ACharacter
 	/** Global notification when a character un-equips a weapon. Needed for replication graph. */
 	SHOOTERGAME_API static FOnShooterCharacterUnEquipWeapon NotifyUnEquipWeapon;
 
+	/** Global notification when a weapon enters a character's inventory. Needed for replication graph. */
+	SHOOTERGAME_API static FOnShooterCharacterInventoryWeapon NotifyAddInventoryWeapon;
+
+	/** Global notification when a weapon leaves a character's inventory. Needed for replication graph. */
+	SHOOTERGAME_API static FOnShooterCharacterInventoryWeapon NotifyRemoveInventoryWeapon;
+
+	/** [server] weapon entered inventory, clients pick it up through the weapon's owner replication */
+	virtual void OnInventoryWeaponAdded(class AShooterWeapon* Weapon);
+
+	/** [server] weapon is leaving inventory */
+	virtual void OnInventoryWeaponRemoved(class AShooterWeapon* Weapon);
+
 	/** get weapon attach point */
 	FName GetWeaponAttachPoint() const;
 
@@ -236,6 +258,12 @@ class AShooterCharacter : public ACharacter
 	UFUNCTION(BlueprintCallable, Category = Pawn)
 	bool IsSprinting() const;
 
+	/** get sprint intent, regardless of current velocity */
+	bool WantsToSprint() const;
+
+	/** get jump state */
+	bool IsJumping() const;
+
 	/** get camera view type */
 	UFUNCTION(BlueprintCallable, Category = Mesh)
 		virtual bool IsFirstPerson() const;
@@ -259,7 +287,7 @@ class AShooterCharacter : public ACharacter
 	USkeletalMeshComponent* GetSpecifcPawnMesh(bool WantFirstPerson) const;
 
 	/** Update the team color of all player meshes. */
-	void UpdateTeamColorsAllMIDs();
+	void UpdateTeamColors();
 private:
 
 	/** pawn mesh: 1st person view */
@@ -303,8 +331,7 @@ protected:
 
 	/** weapons in inventory */
 	UPROPERTY(Transient, Replicated)
-	//UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated)
-	TArray<class AShooterWeapon*> Inventory;
+	FShooterInventoryList Inventory;
 
 	/** currently equipped weapon */
 	UPROPERTY(Transient, ReplicatedUsing = OnRep_CurrentWeapon)
@@ -352,9 +379,13 @@ protected:
 	/** Base lookup rate, in deg/sec. Other scaling may affect final lookup rate. */
 	float BaseLookUpRate;
 
-	/** material instances for setting team color in mesh (3rd person view) */
-	UPROPERTY(Transient)
-	TArray<UMaterialInstanceDynamic*> MeshMIDs;
+	/** materials read team color from custom primitive data instead of the "Team Color Index" parameter */
+	UPROPERTY(EditDefaultsOnly, Category = Mesh)
+	uint32 bTeamColorFromPrimitiveData : 1;
+
+	/** custom primitive data slot read by the materials, used with bTeamColorFromPrimitiveData */
+	UPROPERTY(EditDefaultsOnly, Category = Mesh, meta = (EditCondition = "bTeamColorFromPrimitiveData"))
+	int32 TeamColorPrimitiveDataIndex;
 
 	/** animation played on death */
 	UPROPERTY(EditDefaultsOnly, Category = Animation)
@@ -362,31 +393,34 @@ protected:
 
 	/** sound played on death, local player only */
 	UPROPERTY(EditDefaultsOnly, Category = Pawn)
-	USoundCue* DeathSound;
+	TSoftObjectPtr<USoundCue> DeathSound;
 
 	/** effect played on respawn */
 	UPROPERTY(EditDefaultsOnly, Category = Pawn)
-	UParticleSystem* RespawnFX;
+	TSoftObjectPtr<UParticleSystem> RespawnFX;
 
 	/** sound played on respawn */
 	UPROPERTY(EditDefaultsOnly, Category = Pawn)
-	USoundCue* RespawnSound;
+	TSoftObjectPtr<USoundCue> RespawnSound;
 
 	/** sound played when health is low */
 	UPROPERTY(EditDefaultsOnly, Category = Pawn)
-	USoundCue* LowHealthSound;
+	TSoftObjectPtr<USoundCue> LowHealthSound;
 
 	/** sound played when running */
 	UPROPERTY(EditDefaultsOnly, Category = Pawn)
-	USoundCue* RunLoopSound;
+	TSoftObjectPtr<USoundCue> RunLoopSound;
 
 	/** sound played when stop running */
 	UPROPERTY(EditDefaultsOnly, Category = Pawn)
-	USoundCue* RunStopSound;
+	TSoftObjectPtr<USoundCue> RunStopSound;
 
 	/** sound played when targeting state changes */
 	UPROPERTY(EditDefaultsOnly, Category = Pawn)
-	USoundCue* TargetingSound;
+	TSoftObjectPtr<USoundCue> TargetingSound;
+
+	/** keeps cosmetic assets loaded on clients, never loaded on dedicated servers */
+	TSharedPtr<struct FStreamableHandle> CosmeticAssetsHandle;
 
 	/** used to manipulate with run loop sound */
 	UPROPERTY()
@@ -402,8 +436,17 @@ protected:
 	/** handle mesh visibility and updates */
 	void UpdatePawnMeshes();
 
-	/** handle mesh colors on specified material instance */
-	void UpdateTeamColors(UMaterialInstanceDynamic* UseMID);
+	/** [client] add or remove 3rd person mesh from the animation budget allocator (remote, alive pawns only) */
+	void UpdateAnimationBudget();
+
+	/** [client] spawn respawn effect and sound, once they are loaded */
+	void PlayRespawnEffects();
+
+	/** is 3rd person mesh registered with the animation budget allocator? */
+	uint8 bAnimationBudgeted : 1;
+
+	/** is 3rd person mesh hidden and not ticking while replication is paused? */
+	uint8 bMeshPausedByReplication : 1;
 
 	/** Responsible for cleaning up bodies on clients. */
 	virtual void TornOff();
@@ -490,14 +533,6 @@ protected:
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerEquipWeapon(class AShooterWeapon* NewWeapon);
 
-	/** update targeting state */
-	UFUNCTION(reliable, server, WithValidation)
-	void ServerSetTargeting(bool bNewTargeting);
-
-	/** update targeting state */
-	UFUNCTION(reliable, server, WithValidation)
-	void ServerSetSprinting(bool bNewRunning, bool bToggle);
-
 	/** Builds list of points to check for pausing replication for a connection*/
 	void BuildPauseReplicationCheckPoints(TArray<FVector>& RelevancyCheckPoints);
 
@@ -521,13 +556,6 @@ protected:
 
 	void SetIsJumping(bool NewJumping);
 
-	UFUNCTION(Reliable, Server, WithValidation)
-		void ServerSetIsJumping(bool NewJumping);
-
-	//	void ServerSetIsJumping_Implementation(bool NewJumping);
-
-		//bool ServerSetIsJumping_Validate(bool NewJumping);
-
 	virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode = 0) override;
 
 	/** player pressed jump action */
@@ -13,5 +13,46 @@ class UShooterCharacterMovement : public UCharacterMovementComponent
 	GENERATED_UCLASS_BODY()
 
 	virtual float GetMaxSpeed() const override;
+
+	/** [server] read sprint / targeting / jump intent sent with the move */
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+
+	/** [local] replay saved moves, keeping current sprint / targeting / jump intent */
+	virtual bool ClientUpdatePositionAfterServerUpdate() override;
+
+	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+};
+
+/** saved move carrying sprint, targeting and jump intent in custom compressed flags */
+class FSavedMove_Shooter : public FSavedMove_Character
+{
+public:
+
+	typedef FSavedMove_Character Super;
+
+	/** sprint intent when the move was made */
+	uint8 bSavedWantsToSprint : 1;
+
+	/** targeting state when the move was made */
+	uint8 bSavedIsTargeting : 1;
+
+	/** jump state when the move was made */
+	uint8 bSavedIsJumping : 1;
+
+	virtual void Clear() override;
+	virtual uint8 GetCompressedFlags() const override;
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+	virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, class FNetworkPredictionData_Client_Character& ClientData) override;
+	virtual void PrepMoveFor(ACharacter* Character) override;
 };
 
+class FNetworkPredictionData_Client_Shooter : public FNetworkPredictionData_Client_Character
+{
+public:
+
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FNetworkPredictionData_Client_Shooter(const UCharacterMovementComponent& ClientMovement);
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterCorpseManager.generated.h"
+
+class AShooterCharacter;
+
+/** Keeps the number of simulating ragdolls and lingering corpses bounded */
+UCLASS()
+class UShooterCorpseManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/**
+	* [all] pawn switched to ragdoll. Freezes or recycles older corpses if over budget.
+	*
+	* @param Corpse	Dead character that started simulating physics.
+	*/
+	void RegisterCorpse(AShooterCharacter* Corpse);
+
+	/**
+	* [all] corpse is going away
+	*
+	* @param Corpse	Dead character being destroyed.
+	*/
+	void UnregisterCorpse(AShooterCharacter* Corpse);
+
+	/** get number of corpses still simulating physics */
+	int32 GetNumSimulatingCorpses() const;
+
+protected:
+
+	struct FCorpseInfo
+	{
+		TWeakObjectPtr<AShooterCharacter> Character;
+
+		/** time when ragdoll started */
+		float StartTime;
+
+		/** time when bodies were first found at rest, 0 if moving */
+		float RestStartTime;
+
+		/** bodies asleep and skeleton no longer updated */
+		bool bFrozen;
+	};
+
+	/** tracked corpses, oldest first */
+	TArray<FCorpseInfo> Corpses;
+
+	/** Handle for efficient management of UpdateCorpses timer */
+	FTimerHandle TimerHandle_UpdateCorpses;
+
+	/** freeze settled bodies and enforce budgets */
+	void UpdateCorpses();
+
+	/** freeze oldest simulating corpses until under simulation budget */
+	void EnforceSimulationBudget();
+
+	/** destroy oldest / farthest corpses until under corpse budget */
+	void EnforceCorpseBudget();
+
+	/** put bodies to sleep and stop updating the skeleton */
+	void FreezeCorpse(FCorpseInfo& Info);
+
+	/** recycle score, higher is destroyed first */
+	float GetRecycleScore(const FCorpseInfo& Info, const TArray<FVector>& ViewLocations) const;
+};
@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterPawnRegistry.generated.h"
+
+class AShooterCharacter;
+
+/**
+ * Structure of arrays registry of characters in the world, with a uniform 2D spatial hash on top.
+ * Data is pulled from the characters at most once per frame, on first query.
+ */
+UCLASS()
+class UShooterPawnRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** filter called with registry index, return true to accept the character */
+	typedef TFunctionRef<bool(int32)> FPawnFilter;
+
+	virtual void Deinitialize() override;
+
+	/** [all] character entered the world */
+	void RegisterCharacter(AShooterCharacter* Character);
+
+	/** [all] character left the world */
+	void UnregisterCharacter(AShooterCharacter* Character);
+
+	/**
+	* Find closest accepted character.
+	*
+	* @param Origin		Query location.
+	* @param MaxRadius	Max distance to look at.
+	* @param Filter		Called for candidates, nearest cells first.
+	* @return Registry index or INDEX_NONE.
+	*/
+	int32 FindNearest(const FVector& Origin, float MaxRadius, FPawnFilter Filter);
+
+	/**
+	* Find up to K closest accepted characters, sorted by distance.
+	*
+	* @param Origin		Query location.
+	* @param K			Max number of results.
+	* @param MaxRadius	Max distance to look at.
+	* @param Filter		Called for candidates.
+	* @param OutIndices	Registry indices, closest first.
+	*/
+	void FindKNearest(const FVector& Origin, int32 K, float MaxRadius, FPawnFilter Filter, TArray<int32>& OutIndices);
+
+	/**
+	* Find closest accepted living character outside of a team, using the per team hash.
+	*
+	* @param Origin			Query location.
+	* @param ExcludeTeamNum	Team whose members are skipped without being looked at, INDEX_NONE to skip none.
+	* @param MaxRadius		Max distance to look at.
+	* @param Filter			Called for candidates.
+	* @return Registry index or INDEX_NONE.
+	*/
+	int32 FindNearestHostile(const FVector& Origin, int32 ExcludeTeamNum, float MaxRadius, FPawnFilter Filter);
+
+	/**
+	* Find up to K closest accepted living characters outside of a team, sorted by distance.
+	*
+	* @param Origin			Query location.
+	* @param ExcludeTeamNum	Team whose members are skipped without being looked at, INDEX_NONE to skip none.
+	* @param K				Max number of results.
+	* @param MaxRadius		Max distance to look at.
+	* @param Filter			Called for candidates.
+	* @param OutIndices		Registry indices, closest first.
+	*/
+	void FindKNearestHostile(const FVector& Origin, int32 ExcludeTeamNum, int32 K, float MaxRadius, FPawnFilter Filter, TArray<int32>& OutIndices);
+
+	/**
+	* Find all accepted characters within radius in the XY plane, unsorted.
+	*
+	* @param Origin		Query location.
+	* @param Radius		2D distance to look at, filter can check height.
+	* @param Filter		Called for candidates.
+	* @param OutIndices	Registry indices.
+	*/
+	void FindInRadius(const FVector& Origin, float Radius, FPawnFilter Filter, TArray<int32>& OutIndices);
+
+	/** get number of registered characters, valid until next frame */
+	int32 Num();
+
+	/** get character at registry index */
+	AShooterCharacter* GetCharacter(int32 Index) const { return Characters[Index]; }
+
+	/** get cached location at registry index */
+	const FVector& GetLocation(int32 Index) const { return Locations[Index]; }
+
+	/** get cached team number at registry index, INDEX_NONE without player state */
+	int32 GetTeamNum(int32 Index) const { return TeamNums[Index]; }
+
+	/** check cached alive flag at registry index */
+	bool IsAlive(int32 Index) const { return AliveFlags[Index]; }
+
+	/** check if character at registry index is controlled by AI */
+	bool IsBot(int32 Index) const { return BotFlags[Index]; }
+
+	/** get cached scaled capsule radius at registry index */
+	float GetCapsuleRadius(int32 Index) const { return CapsuleRadii[Index]; }
+
+	/** get cached scaled capsule half height at registry index */
+	float GetCapsuleHalfHeight(int32 Index) const { return CapsuleHalfHeights[Index]; }
+
+	/** get biggest cached capsule radius, to pad radius queries */
+	float GetMaxCapsuleRadius() const { return MaxCapsuleRadius; }
+
+protected:
+
+	/** registered characters, same order as cached data below */
+	UPROPERTY(Transient)
+	TArray<AShooterCharacter*> Characters;
+
+	TArray<FVector> Locations;
+	TArray<int32> TeamNums;
+	TBitArray<> AliveFlags;
+	TBitArray<> BotFlags;
+	TArray<float> CapsuleRadii;
+	TArray<float> CapsuleHalfHeights;
+	float MaxCapsuleRadius = 0.0f;
+
+	/** spatial hash: first registry index per cell, linked through NextInCell */
+	TMap<FIntPoint, int32> CellHeads;
+	TArray<int32> NextInCell;
+
+	/** per team spatial hash of living characters: first registry index per (cell, team), linked through NextInTeamCell */
+	TMap<FIntVector, int32> TeamCellHeads;
+	TArray<int32> NextInTeamCell;
+
+	/** teams present in TeamCellHeads */
+	TArray<int32, TInlineAllocator<4>> HashedTeams;
+
+	/** bounds of occupied cells */
+	FIntPoint MinCell;
+	FIntPoint MaxCell;
+
+	/** cell size used for the current hash */
+	float CellSize = 1.0f;
+
+	/** frame of last refresh */
+	uint64 LastRefreshFrame = 0;
+
+	/** pull data from characters and rebuild the hash, once per frame */
+	void ConditionalRefresh();
+
+	/** get hash cell for location */
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** visit cells within occupied bounds at Chebyshev distance Ring from Center */
+	template<typename Func>
+	void ForEachCellInRing(const FIntPoint& Center, int32 Ring, Func&& VisitCell) const;
+
+	/** ring search shared by nearest queries, ForEachInCell(X, Y, Visit) feeds registry indices of a cell */
+	template<typename CellFunc>
+	void FindKNearestInCells(const FVector& Origin, int32 K, float MaxRadius, FPawnFilter Filter, TArray<int32>& OutIndices, CellFunc&& ForEachInCell);
+};
@@ -30,9 +30,16 @@ public:
 	UFUNCTION(reliable, client)
 	void ClientEndOnlineGame();	
 
+	/** shot counts are only tracked on the server, hand them over before the match ends */
+	UFUNCTION(reliable, client)
+	void ClientSetShotStats(int32 NumBulletsFired, int32 NumRocketsFired);
+
 	/** notify player about finished match */
 	virtual void ClientGameEnded_Implementation(class AActor* EndGameFocus, bool bIsWinner);
 
+	/** match restarts in the same world, back to warmup */
+	virtual void ClientReset_Implementation() override;
+
 	/** Notifies clients to send the end-of-round event */
 	UFUNCTION(reliable, client)
 	void ClientSendRoundEndEvent(bool bIsWinner, int32 ExpendedTimeInSeconds);
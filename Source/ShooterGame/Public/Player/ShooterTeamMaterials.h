@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterTeamMaterials.generated.h"
+
+/**
+ * One material instance per material and team, shared by all characters of that team.
+ * Sets the "Team Color Index" parameter, so meshes of the same team keep batching together.
+ */
+UCLASS()
+class UShooterTeamMaterials : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/** [client] swap all materials of mesh for the shared instances of team */
+	void ApplyTeamColor(UMeshComponent* Mesh, int32 TeamNum);
+
+	/**
+	* Get shared team instance of material.
+	*
+	* @param Material	Source material, or a team instance created here.
+	* @param TeamNum	Team to color for.
+	* @return Shared instance, or NULL without source material.
+	*/
+	UMaterialInstanceDynamic* GetTeamMaterial(UMaterialInterface* Material, int32 TeamNum);
+
+protected:
+
+	/** keeps the shared instances alive */
+	UPROPERTY(Transient)
+	TArray<UMaterialInstanceDynamic*> TeamMaterials;
+
+	/** shared instance by source material and team */
+	TMap<TPair<const UMaterialInterface*, int32>, UMaterialInstanceDynamic*> TeamMaterialMap;
+};
@@ -123,10 +123,14 @@ struct FTakeHitInfo
 	UPROPERTY()
 	TWeakObjectPtr<class AShooterCharacter> PawnInstigator;
 
-	/** Who actually caused the damage */
-	UPROPERTY()
+	/** Who actually caused the damage, [server] only */
+	UPROPERTY(NotReplicated)
 	TWeakObjectPtr<class AActor> DamageCauser;
 
+	/** Where the victim was when hit, [server] only, direction fallback for radial damage without component hits */
+	UPROPERTY(NotReplicated)
+	FVector VictimLocation;
+
 	/** Specifies which DamageEvent below describes the damage received. */
 	UPROPERTY()
 	int32 DamageEventClassID;
@@ -153,10 +157,155 @@ private:
 	UPROPERTY()
 	FRadialDamageEvent RadialDamageEvent;
 
+	/** Index of DamageTypeClass in UShooterDamageTypeRegistry, sent instead of the class. */
+	uint8 DamageTypeIndex;
+
 public:
 	FTakeHitInfo();
 
 	FDamageEvent& GetDamageEvent();
 	void SetDamageEvent(const FDamageEvent& DamageEvent);
 	void EnsureReplication();
-};
\ No newline at end of file
+
+	/** [server] look up index DamageTypeClass is replicated with, after SetDamageEvent */
+	void UpdateDamageTypeIndex(const UObject* WorldContextObject);
+
+	/** [client] look up DamageTypeClass from replicated index, before GetDamageEvent */
+	void ResolveDamageTypeClass(const UObject* WorldContextObject);
+
+	/** quantized replication: damage, damage type index, event kind, direction byte and compressed radial origin */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FTakeHitInfo> : public TStructOpsTypeTraitsBase2<FTakeHitInfo>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/** single inventory slot */
+USTRUCT()
+struct FShooterInventoryEntry : public FFastArraySerializerItem
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** weapon in this slot */
+	UPROPERTY()
+	class AShooterWeapon* Weapon;
+
+	/** order of this slot in the inventory, entries are not kept in order on clients */
+	UPROPERTY()
+	int32 Slot;
+
+	FShooterInventoryEntry()
+		: Weapon(nullptr)
+		, Slot(0)
+	{
+	}
+
+	/** [client] replication callbacks, slot order needs rebuilding */
+	void PreReplicatedRemove(const struct FShooterInventoryList& InArraySerializer);
+	void PostReplicatedAdd(const struct FShooterInventoryList& InArraySerializer);
+	void PostReplicatedChange(const struct FShooterInventoryList& InArraySerializer);
+};
+
+/** weapons in inventory, replicated per slot instead of resending the whole list */
+USTRUCT()
+struct FShooterInventoryList : public FFastArraySerializer
+{
+	GENERATED_USTRUCT_BODY()
+
+	FShooterInventoryList()
+		: NextSlot(0)
+		, bSlotOrderDirty(false)
+	{
+	}
+
+	/** [server] add weapon if not already in inventory, returns true if added */
+	bool AddUnique(class AShooterWeapon* Weapon);
+
+	/** [server] remove weapon from inventory, returns true if removed */
+	bool RemoveSingle(class AShooterWeapon* Weapon);
+
+	/** get slot index of weapon in inventory, INDEX_NONE if not found */
+	int32 IndexOfByKey(const class AShooterWeapon* Weapon) const;
+
+	int32 Num() const { return Entries.Num(); }
+
+	/** get weapon at slot index. Index validity is not checked. */
+	class AShooterWeapon* operator[](int32 Index) const { return Entries[GetSlotOrder()[Index]].Weapon; }
+
+	/** entries changed, slot order is rebuilt on next access */
+	void MarkSlotOrderDirty() const { bSlotOrderDirty = true; }
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FShooterInventoryEntry, FShooterInventoryList>(Entries, DeltaParms, *this);
+	}
+
+private:
+
+	UPROPERTY()
+	TArray<FShooterInventoryEntry> Entries;
+
+	/** [server] slot given to next added weapon */
+	int32 NextSlot;
+
+	/** entry indices sorted by slot */
+	mutable TArray<int32> SlotOrder;
+
+	/** SlotOrder needs rebuilding */
+	mutable bool bSlotOrderDirty;
+
+	/** get entry indices sorted by slot */
+	const TArray<int32>& GetSlotOrder() const;
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterInventoryList> : public TStructOpsTypeTraitsBase2<FShooterInventoryList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/** availability of all level pickups, one bit per pickup in FShooterPickupManager order */
+USTRUCT()
+struct FShooterPickupAvailability
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** number of pickups the server registered, clients apply bits once they have as many */
+	UPROPERTY()
+	int32 NumPickups;
+
+	/** active flag per pickup */
+	UPROPERTY()
+	TArray<uint32> Bits;
+
+	FShooterPickupAvailability()
+		: NumPickups(0)
+	{
+	}
+
+	bool IsAvailable(int32 Index) const
+	{
+		return (Bits[Index >> 5] & (1u << (Index & 31))) != 0;
+	}
+
+	void SetAvailable(int32 Index, bool bAvailable)
+	{
+		if (bAvailable)
+		{
+			Bits[Index >> 5] |= (1u << (Index & 31));
+		}
+		else
+		{
+			Bits[Index >> 5] &= ~(1u << (Index & 31));
+		}
+	}
+};
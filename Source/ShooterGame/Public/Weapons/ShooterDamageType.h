@@ -5,7 +5,7 @@
 #include "ShooterDamageType.generated.h"
 
 // DamageType class that specifies an icon to display
-UCLASS(const, Blueprintable, BlueprintType)
+UCLASS(const, Blueprintable, BlueprintType, Config=Game)
 class UShooterDamageType : public UDamageType
 {
 	GENERATED_UCLASS_BODY()
@@ -21,6 +21,10 @@ class UShooterDamageType : public UDamageType
 	/** force feedback effect to play on a player killed by this damage type */
 	UPROPERTY(EditDefaultsOnly, Category=Effects)
 	UForceFeedbackEffect *KilledForceFeedback;
+
+	/** damage types replicated by index in hit info, anything else is sent as a class reference */
+	UPROPERTY(Config)
+	TArray<FSoftClassPath> ReplicatedDamageTypes;
 };
 
 
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterDamageTypeRegistry.generated.h"
+
+/**
+ * Maps damage type classes to the small indices hit info is replicated with, both ways.
+ * Classes come from UShooterDamageType::ReplicatedDamageTypes and are held weakly. Entries that failed to load
+ * or went stale are resolved again on the next lookup that misses, at most once per frame.
+ */
+UCLASS()
+class UShooterDamageTypeRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** index of classes not in the registry, they are replicated as a class reference instead */
+	static const uint8 UnregisteredIndex = 0xFF;
+
+	/** get index of damage type class, 0 for the default damage type */
+	uint8 GetIndex(UClass* DamageTypeClass);
+
+	/** get damage type class of index, the default damage type when it can't be resolved */
+	UClass* GetClass(uint8 Index);
+
+	/** helper for game code: get registry of world */
+	static UShooterDamageTypeRegistry* Get(const UObject* WorldContextObject);
+
+protected:
+
+	/** resolved class of each configured entry, index 0 is entry 1 */
+	TArray<TWeakObjectPtr<UClass>> Classes;
+
+	/** index of each resolved class */
+	TMap<TWeakObjectPtr<UClass>, uint8> Indices;
+
+	/** frame of last resolve pass */
+	uint64 LastResolveFrame = 0;
+
+	/** load missing entries and rebuild Indices when any changed, once per frame */
+	void ConditionalResolve();
+};
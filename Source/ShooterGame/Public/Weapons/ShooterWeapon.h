@@ -13,6 +13,7 @@ class UParticleSystemComponent;
 class UForceFeedbackEffect;
 class USoundCue;
 class UMatineeCameraShake;
+struct FStreamableHandle;
 
 namespace EWeaponState
 {
@@ -99,6 +100,9 @@ class AShooterWeapon : public AActor
 
 	virtual void Destroyed() override;
 
+	/** [client] get cosmetic assets to load, never loaded on dedicated servers */
+	virtual void GetCosmeticAssets(TArray<FSoftObjectPath>& OutAssets) const;
+
 	//////////////////////////////////////////////////////////////////////////
 	// Ammo
 	
@@ -254,27 +258,27 @@ protected:
 	FName MuzzleAttachPoint;
 
 	UPROPERTY(EditDefaultsOnly, Category=Effects)
-	UParticleSystem* MuzzleFX;
+	TSoftObjectPtr<UParticleSystem> MuzzleFX;
 
 	// todo?
 	UPROPERTY(Transient)
 	UParticleSystemComponent* MuzzlePSC;
 
 	UPROPERTY(EditDefaultsOnly, Category=Effects)
-	TSubclassOf<UMatineeCameraShake> FireCameraShake;
+	TSoftClassPtr<UMatineeCameraShake> FireCameraShake;
 
 	UPROPERTY(EditDefaultsOnly, Category=Sound)
-	USoundCue* FireSound;
+	TSoftObjectPtr<USoundCue> FireSound;
 
 
 	UPROPERTY(EditDefaultsOnly, Category=Sound)
-	USoundCue* ReloadSound;
+	TSoftObjectPtr<USoundCue> ReloadSound;
 
 	UPROPERTY(EditDefaultsOnly, Category=Animation)
 	FWeaponAnim ReloadAnim;
 
 	UPROPERTY(EditDefaultsOnly, Category=Sound)
-	USoundCue* EquipSound;
+	TSoftObjectPtr<USoundCue> EquipSound;
 
 	UPROPERTY(EditDefaultsOnly, Category=Animation)
 	FWeaponAnim EquipAnim;
@@ -282,6 +286,9 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category=Animation)
 	FWeaponAnim FireAnim;
 
+	/** keeps cosmetic assets loaded on clients */
+	TSharedPtr<FStreamableHandle> CosmeticAssetsHandle;
+
 	uint32 bIsEquipped : 1;
 
 	/** current weapon state */
@@ -405,7 +412,7 @@ protected:
 
 	public:
 		UPROPERTY(EditDefaultsOnly, Category = Sound)
-			USoundCue* OutOfAmmoSound;
+			TSoftObjectPtr<USoundCue> OutOfAmmoSound;
 		UPROPERTY(EditAnywhere, BlueprintReadWrite)
 			EWeaponAnimType WeaponAnimType;
 };
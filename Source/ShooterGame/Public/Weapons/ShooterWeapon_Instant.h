@@ -107,11 +107,11 @@ protected:
 
 	/** impact effects */
 	UPROPERTY(EditDefaultsOnly, Category=Effects)
-	TSubclassOf<AShooterImpactEffect> ImpactTemplate;
+	TSoftClassPtr<AShooterImpactEffect> ImpactTemplate;
 
 	/** smoke trail */
 	UPROPERTY(EditDefaultsOnly, Category=Effects)
-	UParticleSystem* TrailFX;
+	TSoftObjectPtr<UParticleSystem> TrailFX;
 
 	/** param name for beam target in smoke trail */
 	UPROPERTY(EditDefaultsOnly, Category=Effects)
@@ -150,6 +150,8 @@ protected:
 	/** [local] weapon specific fire implementation */
 	virtual void FireWeapon() override;
 
+	virtual void GetCosmeticAssets(TArray<FSoftObjectPath>& OutAssets) const override;
+
 	UFUNCTION()
 	void OnRep_HitNotify();
 